@@ -1,24 +1,32 @@
 ﻿#ifndef KUMA_ENGINE_API_COLLISION_SYSTEM_H_
 #define KUMA_ENGINE_API_COLLISION_SYSTEM_H_
 
-#include <unordered_map>
+#include <cstdint>
+#include <span>
+#include <vector>
 
+#include "contact_events.h"
+#include "display.h"
 #include "game_object.h"
+#include "physics_world.h"
 #include "quadtree.h"
+#include "solver_settings.h"
+#include "stats.h"
 #include "trigger_system.h"
 
 
 class CollisionSystem
 {
 private:
-    int number_of_objects_ = 200;
-    std::array<GameObject, 200> objects_ = {};
-    physics::Quadtree* quadtree_ = nullptr;
+    static constexpr std::size_t kDefaultObjectCount = 200;
 
-    std::unordered_map<GameObjectPair, bool> potential_pairs_;
-    std::unordered_set<GameObjectPair> active_pairs_;
-    //Mapping from Collider to GameObject
-    std::unordered_map<physics::Collider*, GameObject*> collider_to_object_map_;
+    std::size_t number_of_objects_ = kDefaultObjectCount;
+    //Sized once by Initialize, so the object addresses held by the pairs stay valid
+    std::vector<GameObject> objects_;
+    //Area the objects are spawned in and bounce inside of
+    math::Bounds2f world_bounds_ = math::Bounds2f(math::Vec2f(0, 0), math::Vec2f(kWindowWidth, kWindowHeight));
+    //Pairs, contacts and events of the step, the scene integrates the objects
+    PhysicsWorld world_;
 
 public:
     CollisionSystem() = default;
@@ -27,8 +35,19 @@ public:
     void Initialize();
     void Clear();
 
-    std::array<GameObject, 200> objects() { return objects_; }
-    [[nodiscard]] physics::Quadtree* quadtree() const { return quadtree_; }
+    //Live storage of the scene, read in place, valid until objects are added or removed
+    [[nodiscard]] std::span<GameObject> objects() { return objects_; }
+    [[nodiscard]] std::span<const GameObject> objects() const { return objects_; }
+    //Number of objects created by the next Initialize
+    void set_object_count(const std::size_t count) { number_of_objects_ = count; }
+    //Bounds used by the next Initialize, larger scenes keep their density in a larger world
+    void set_world_bounds(const math::Bounds2f& bounds) { world_bounds_ = bounds; }
+    [[nodiscard]] PhysicsWorld& world() { return world_; }
+    [[nodiscard]] physics::Quadtree* quadtree() const { return world_.quadtree(); }
+    [[nodiscard]] physics::SolverSettings& solver_settings() { return world_.solver_settings(); }
+    [[nodiscard]] const physics::ContactEventQueue<GameObject*>& contact_events() const { return world_.contact_events(); }
+    [[nodiscard]] std::uint64_t step_hash() const { return world_.step_hash(); }
+    [[nodiscard]] physics::Stats& stats() { return world_.stats(); }
 
     void CreateObject(size_t index, math::Circle& circle);
     void CreateObject(size_t index, math::AABB& aabb);
@@ -41,12 +60,7 @@ public:
     void Update(float delta_time);
     void UpdateShapes(float delta_time);
 
-    void SimplisticBroadPhase();
-    void BroadPhase();
-    void NarrowPhase();
-
-    static void OnPairCollideStart(const GameObjectPair& pair);
-    static void OnPairCollideStay(const GameObjectPair& pair);
-    static void OnPairCollideEnd(const GameObjectPair& pair);
+    //Calls the game object callbacks of the recorded events, once after the fixed steps, then empties the queue
+    void DispatchContactEvents();
 };
 #endif // KUMA_ENGINE_API_COLLISION_SYSTEM_H_
@@ -1,29 +1,34 @@
 ﻿#ifndef KUMA_ENGINE_API_FRICTION_SYSTEM_H_
 #define KUMA_ENGINE_API_FRICTION_SYSTEM_H_
 
-#include <unordered_map>
-#include <unordered_set>
+#include <cstdint>
+#include <span>
+#include <vector>
 
+#include "contact_events.h"
 #include "display.h"
 #include "game_object.h"
+#include "physics_world.h"
 #include "quadtree.h"
 #include "shape.h"
+#include "solver_settings.h"
+#include "stats.h"
 #include "timer.h"
 
 class FrictionSystem
 {
 private:
-    std::vector<GameObject> objects_;
-
-    physics::Quadtree* quadtree_ = nullptr;
+    static constexpr std::size_t kDefaultObjectCapacity = 1000;
 
-    std::unordered_map<GameObjectPair, bool> potential_pairs_;
-    std::unordered_set<GameObjectPair> active_pairs_;
+    //Reserved once by Initialize and never grown, so the object addresses held by the pairs stay valid
+    std::vector<GameObject> objects_;
+    std::size_t object_capacity_ = kDefaultObjectCapacity;
 
-    std::unordered_map<physics::Collider*, GameObject*> collider_to_object_map_; //Mapping from Collider to GameObject
+    //Pairs, contacts and events of the step, the scene integrates the objects
+    PhysicsWorld world_{physics::SolverSettings{4, 4, 2}};
 
     Timer* timer_ = nullptr;
-    math::AABB frame_bounds_ = math::AABB(math::Vec2f(0, 0), math::Vec2f(kWindowWidth, kWindowHeight));
+    math::Bounds2f frame_bounds_ = math::Bounds2f(math::Vec2f(0, 0), math::Vec2f(kWindowWidth, kWindowHeight));
 
 public:
     FrictionSystem() = default;
@@ -32,13 +37,22 @@ public:
     void Initialize();
     void Clear();
 
-    std::vector<GameObject> objects() { return objects_; }
-    [[nodiscard]] physics::Quadtree* quadtree() const { return quadtree_; }
+    //Live storage of the scene, read in place, valid until objects are added or removed
+    [[nodiscard]] std::span<GameObject> objects() { return objects_; }
+    [[nodiscard]] std::span<const GameObject> objects() const { return objects_; }
+    //Number of objects, the ground included, the next Initialize makes room for
+    void set_object_capacity(const std::size_t capacity) { object_capacity_ = capacity; }
+    [[nodiscard]] PhysicsWorld& world() { return world_; }
+    [[nodiscard]] physics::Quadtree* quadtree() const { return world_.quadtree(); }
+    [[nodiscard]] physics::SolverSettings& solver_settings() { return world_.solver_settings(); }
+    [[nodiscard]] const physics::ContactEventQueue<GameObject*>& contact_events() const { return world_.contact_events(); }
+    [[nodiscard]] std::uint64_t step_hash() const { return world_.step_hash(); }
+    [[nodiscard]] physics::Stats& stats() { return world_.stats(); }
 
     void SpawnShape(math::Vec2f pos, math::ShapeType type);
     void CreateObject(size_t index, math::Circle& circle);
     void CreateObject(size_t index, math::AABB& aabb);
-    //void CreateObject(size_t index, math::Polygon& polygon);
+    void CreateObject(size_t index, math::Polygon& polygon);
     void CreateGround();
     void DeleteObject(size_t index);
     void RemoveOutOfBoundsObjects();
@@ -49,13 +63,8 @@ public:
     void Update(float delta_time);
     void UpdateShapes(float delta_time);
 
-    void SimplisticBroadPhase();
-    void BroadPhase();
-    void NarrowPhase();
-
-    static void OnPairCollideStart(const GameObjectPair& pair);
-    static void OnPairCollideStay(const GameObjectPair& pair);
-    static void OnPairCollideEnd(const GameObjectPair& pair);
+    //Calls the game object callbacks of the recorded events, once after the fixed steps, then empties the queue
+    void DispatchContactEvents();
 };
 
 #endif //KUMA_ENGINE_API_FRICTION_SYSTEM_H_
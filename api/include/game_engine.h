@@ -1,14 +1,25 @@
 #ifndef KUMA_ENGINE_API_GAME_ENGINE_H_
 #define KUMA_ENGINE_API_GAME_ENGINE_H_
 
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <stop_token>
+#include <thread>
+#include <vector>
+
 #include "collision_system.h"
 #include "display.h"
 #include "friction_system.h"
 #include "graphics_manager.h"
 #include "imgui_interface.h"
 #include "planet_system.h"
+#include "render_snapshot.h"
+#include "stats.h"
+#include "step_budget.h"
 #include "timer.h"
 #include "trigger_system.h"
+#include "triple_buffer.h"
 
 enum class SystemScene
 {
@@ -18,10 +29,39 @@ enum class SystemScene
     FrictionSystemScene
 };
 
+//Panel values read by the steps, the frames hand them to the step loop when they change
+struct StepInputs
+{
+    float speed_multiplier = 1.0f;
+    SDL_Color planets_colour{255, 13, 132, 255};
+    bool show_quadtree = false;
+
+    [[nodiscard]] bool operator==(const StepInputs& other) const
+    {
+        return speed_multiplier == other.speed_multiplier && show_quadtree == other.show_quadtree &&
+            planets_colour.r == other.planets_colour.r && planets_colour.g == other.planets_colour.g &&
+            planets_colour.b == other.planets_colour.b && planets_colour.a == other.planets_colour.a;
+    }
+};
+
+//Step loop state shown by the panel, copied once per frame so the panel is built without the scene lock
+struct PanelState
+{
+    physics::Stats stats{};
+    physics::StatsHistory stats_history{};
+    std::uint64_t step_hash = 0;
+    std::uint64_t scene_seed = 0;
+    bool has_solver_settings = false;
+    physics::SolverSettings solver_settings{};
+    physics::StepBudget step_budget{};
+};
+
 class GameEngine
 {
 private:
     SystemScene selected_scene_ = SystemScene::PlanetSystemScene;
+    //Seed of the random numbers of a deterministic scene, the other scenes draw a new one at every reset
+    std::uint64_t scene_seed_ = common::rng::Engine::kDefaultSeed;
     bool is_running_;
 
     Display* display_;
@@ -34,14 +74,74 @@ private:
 
     ImGuiInterface* imgui_interface_;
 
+    //Caps the steps of a frame and lowers the solver work under load
+    physics::StepBudget step_budget_{};
+    //Last steps of the selected scene, recorded by the step loop for the performance overlay
+    physics::StatsHistory stats_history_{};
+
+    //Physics thread mode, the thread runs the fixed steps and publishes a snapshot after each of them
+    //The frames draw the latest snapshot, post the input and the panel changes as commands the thread runs
+    //at the start of its next step, and only take the scene lock to copy the panel state
+    std::jthread physics_thread_;
+    std::mutex scene_mutex_;
+    common::TripleBuffer<RenderSnapshot> snapshots_;
+    std::mutex command_mutex_;
+    std::vector<std::function<void()>> commands_;
+    std::vector<std::function<void()>> running_commands_;
+
+    StepInputs step_inputs_{};
+    StepInputs posted_inputs_{};
+    PanelState panel_state_{};
+
+    //Planets gathered each frame for GraphicsManager::CreateCircles, the capacity is kept between frames
+    std::vector<math::Vec2f> circle_centres_;
+    std::vector<float> circle_radii_;
+    std::vector<SDL_Color> circle_colors_;
+
     void HandleEvents();
+    void PostStepInputs();
+    void RunCommands();
+    void ResetScene(SystemScene new_sample);
+    void UpdatePanelState();
+    [[nodiscard]] physics::SolverSettings* scene_solver_settings() const;
+    [[nodiscard]] std::uint64_t scene_step_hash() const;
+    [[nodiscard]] const physics::Stats& scene_stats() const;
+    void StepScene(float fixed_time_step);
+    void DispatchSceneEvents();
+    void BuildRenderGeometry(float alpha);
+    void WriteSnapshot(RenderSnapshot& snapshot);
+    void DrawSnapshot(const RenderSnapshot& snapshot, float alpha);
+    void PhysicsLoop(std::stop_token stop_token, float fixed_time_step);
+    void StartPhysicsThread(float fixed_time_step);
+    void StopPhysicsThread();
+    void SeedScene() const;
 
 public:
     GameEngine();
     ~GameEngine();
 
+    //Runs a change of the scenes or of their settings now, or before the next step while the physics thread runs
+    void Post(std::function<void()> command);
+
     void ChangeScene(SystemScene new_sample);
 
+    //Solver settings of the selected scene as of the last frame, nullptr when the scene does not solve contacts
+    [[nodiscard]] const physics::SolverSettings* solver_settings() const;
+    //State hash of the last step of the selected scene, zero when the scene is not deterministic
+    [[nodiscard]] std::uint64_t step_hash() const { return panel_state_.step_hash; }
+    //Time and work of the steps of the selected scene
+    [[nodiscard]] const physics::Stats& stats() const { return panel_state_.stats; }
+    [[nodiscard]] const physics::StatsHistory& stats_history() const { return panel_state_.stats_history; }
+    [[nodiscard]] const physics::StepBudget& step_budget() const { return panel_state_.step_budget; }
+    [[nodiscard]] std::uint64_t scene_seed() const { return panel_state_.scene_seed; }
+
+    //The setters post their change, it shows in the getters from the next frame
+    void set_solver_settings(const physics::SolverSettings& settings);
+    void set_max_steps_per_frame(int max_steps);
+    void set_adaptive(bool adaptive);
+    //Takes effect from the next reset of a deterministic scene
+    void set_scene_seed(std::uint64_t seed);
+
     void Run();
 };
 
@@ -27,7 +27,9 @@ public:
     ~GameObject() = default;
 
     [[nodiscard]] physics::Body& body() { return body_; }
+    [[nodiscard]] const physics::Body& body() const { return body_; }
     [[nodiscard]] physics::Collider& collider() { return collider_; }
+    [[nodiscard]] const physics::Collider& collider() const { return collider_; }
     [[nodiscard]] float radius() const { return radius_; }
     [[nodiscard]] SDL_Color color() const { return color_; }
     [[nodiscard]] math::Vec2f position() const { return body_.position(); }
@@ -54,9 +56,9 @@ public:
     }
     void OnCollisionEnter()
     {
-        Uint8 r = random::Range(128, 255);
-        Uint8 g = random::Range(128, 255);
-        Uint8 b = random::Range(128, 255);
+        Uint8 r = common::rng::Range(128, 255);
+        Uint8 g = common::rng::Range(128, 255);
+        Uint8 b = common::rng::Range(128, 255);
         color_ = SDL_Color{ r, g, b, 255 };
     }
     void OnCollisionExit()
@@ -75,6 +77,12 @@ struct GameObjectPair
         return (gameObjectA_ == other.gameObjectA_ && gameObjectB_ == other.gameObjectB_) ||
             (gameObjectA_ == other.gameObjectB_ && gameObjectB_ == other.gameObjectA_);
     }
+
+    //Lower address first, so a pair sorts the same way whichever object found it
+    [[nodiscard]] std::pair<GameObject*, GameObject*> SortKey() const
+    {
+        return gameObjectA_ < gameObjectB_ ? std::pair(gameObjectA_, gameObjectB_) : std::pair(gameObjectB_, gameObjectA_);
+    }
 };
 
 namespace std
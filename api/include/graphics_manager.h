@@ -2,12 +2,14 @@
 #define KUMA_ENGINE_API_SHAPE_MANAGER_H_
 
 #include <SDL_render.h>
+#include <span>
 #include <vector>
 
 #include "vec2.h"
 
 
 static constexpr size_t kCircleVertexCount = 20;
+static constexpr size_t kCircleIndexCount = 3 * kCircleVertexCount;
 
 class GraphicsManager
 {
@@ -24,10 +26,14 @@ public:
 
     void AddVertex(math::Vec2f position, SDL_Color color);
     void Clear();
-    void CreateCircle(math::Vec2f centre, float radius, SDL_Color color, bool rotation);
+    void CreateCircle(math::Vec2f centre, float radius, SDL_Color color, bool rotation, float orientation = 0.0f);
+    //Unrotated circles, the spans are read in parallel, one circle per centre
+    void CreateCircles(std::span<const math::Vec2f> centres, std::span<const float> radii, std::span<const SDL_Color> colors);
     void CreateAABB(math::Vec2f min, math::Vec2f max, SDL_Color color, bool fill_status);
     void CreateAABB(math::Vec2f centre, float half_size, SDL_Color color, bool fill_status);
-    void CreatePolygon(const std::vector<math::Vec2f>& points, math::Vec2f center, SDL_Color color, bool fill_status);
+    //The offset moves the points, for polygons drawn away from where their vertices were computed
+    void CreatePolygon(std::span<const math::Vec2f> points, math::Vec2f center, SDL_Color color, bool fill_status,
+                       math::Vec2f offset = math::Vec2f::Zero());
 };
 
 #endif // KUMA_ENGINE_API_SHAPE_MANAGER_H_
@@ -12,10 +12,15 @@ class ImGuiInterface
 private:
     GameEngine* game_engine_ = nullptr;
     bool show_quadtree_ = true;
+    bool physics_thread_ = false;
+    bool interpolate_ = true;
     float speed_multiplier_ = 1.0f;
     int current_scene_ = 0;
 
     SDL_Color planets_colour_ = {255, 13, 132};
+
+    void SolverSettingsSliders() const;
+    void PerformanceOverlay() const;
 public:
     ImGuiInterface() = default;
     ~ImGuiInterface();
@@ -26,6 +31,8 @@ public:
     void PassEvents(SDL_Event& event);
 
     [[nodiscard]] bool show_quadtree() const { return show_quadtree_; }
+    [[nodiscard]] bool physics_thread() const { return physics_thread_; }
+    [[nodiscard]] bool interpolate() const { return interpolate_; }
     [[nodiscard]] float speed_multiplier() const { return speed_multiplier_; }
     [[nodiscard]] SDL_Color planets_colour() const { return planets_colour_; }
 };
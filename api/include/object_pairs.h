@@ -0,0 +1,27 @@
+#ifndef KUMA_ENGINE_API_OBJECT_PAIRS_H_
+#define KUMA_ENGINE_API_OBJECT_PAIRS_H_
+
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+#include "game_object.h"
+#include "quadtree.h"
+#include "stats.h"
+
+//Broad phases and pair callbacks shared by the contact pipeline of PhysicsWorld and the sensor pipeline of TriggerSystem
+
+//Fills pairs with every two objects whose bounds overlap, by testing all of them against each other
+void FindPairsBruteForce(std::span<GameObject> objects, std::unordered_map<GameObjectPair, bool>& pairs);
+//Fills pairs with the objects whose bounds overlap, by rebuilding the quadtree and querying it with each moving object
+void FindPairs(std::span<GameObject> objects, physics::Quadtree& quadtree,
+               const std::unordered_map<physics::Collider*, GameObject*>& collider_to_object_map,
+               std::vector<physics::Collider*>& query_results, physics::StepCounters& step,
+               std::unordered_map<GameObjectPair, bool>& pairs);
+
+//Game object callbacks of a pair, called when the events recorded by the steps are dispatched
+void OnPairCollideStart(const GameObjectPair& pair);
+void OnPairCollideStay(const GameObjectPair& pair);
+void OnPairCollideEnd(const GameObjectPair& pair);
+
+#endif //KUMA_ENGINE_API_OBJECT_PAIRS_H_
@@ -0,0 +1,151 @@
+#ifndef KUMA_ENGINE_API_PHYSICS_WORLD_H_
+#define KUMA_ENGINE_API_PHYSICS_WORLD_H_
+
+#include <cstdint>
+#include <span>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "contact_events.h"
+#include "contact_solver.h"
+#include "game_object.h"
+#include "manifold.h"
+#include "profiler.h"
+#include "quadtree.h"
+#include "solver_settings.h"
+#include "stats.h"
+
+//Step pipeline of the scenes that solve contacts: broad phase, continuous collision, narrow phase, solver and contact events
+//The scene owns the objects and integrates them, the world keeps the pairs and contacts found between them
+class PhysicsWorld
+{
+private:
+    physics::Quadtree* quadtree_ = nullptr;
+
+    std::unordered_map<GameObjectPair, bool> potential_pairs_;
+    std::vector<physics::Collider*> query_results_; //Reused by every quadtree query of the broad phase
+    //Potential pairs in the order the phases process them, sorted in deterministic mode
+    std::vector<GameObjectPair> pair_order_;
+    std::vector<GameObjectPair> ended_pairs_; //Pairs that stopped touching during the current step
+    //Time of impact of a pair found by the continuous collision phase
+    struct Impact
+    {
+        GameObjectPair pair;
+        float time;
+    };
+    std::vector<Impact> impacts_; //Impacts of the current substep, earliest first once sorted
+    std::unordered_set<GameObject*> resolved_objects_; //Objects already rewound in the current substep
+    //Acceleration the scene applies to its dynamic bodies, the broad phase bounds grow by the motion it adds
+    math::Vec2f gravity_ = math::Vec2f::Zero();
+    //Bodies moving further than this fraction of their radius in a step use continuous collision detection
+    float ccd_motion_threshold_ = 0.5f;
+    //Substeps and solver iterations used by the scene for each fixed step
+    physics::SolverSettings solver_settings_{};
+    std::unordered_map<GameObjectPair, physics::ContactEvent<GameObject*>> active_pairs_;
+    //Pairs touching during the current step, with the normal of their last contact and the impulse of the step
+    std::unordered_map<GameObjectPair, physics::ContactEvent<GameObject*>> new_active_pairs_;
+    //Begin, stay and end events of the steps since the last dispatch
+    physics::ContactEventQueue<GameObject*> contact_events_;
+    std::uint64_t step_hash_ = 0; //Hash of the bodies after the last step, in deterministic mode
+    physics::Stats stats_{}; //Time and work of the steps, filled every step
+    std::vector<physics::ContactSolver> contacts_; //Contacts of the current substep, solved in batch
+    std::unordered_map<GameObjectPair, math::SatCache> sat_cache_; //Separating axes of the polygon pairs
+
+    std::unordered_map<physics::Collider*, GameObject*> collider_to_object_map_; //Mapping from Collider to GameObject
+
+public:
+    explicit PhysicsWorld(const physics::SolverSettings& solver_settings = {}) : solver_settings_(solver_settings) {}
+    ~PhysicsWorld();
+
+    //The pairs point into the scene storage, a copy would share them
+    PhysicsWorld(const PhysicsWorld&) = delete;
+    PhysicsWorld& operator=(const PhysicsWorld&) = delete;
+
+    void Initialize(const math::Bounds2f& bounds);
+    void Clear();
+
+    [[nodiscard]] physics::Quadtree* quadtree() const { return quadtree_; }
+    [[nodiscard]] physics::SolverSettings& solver_settings() { return solver_settings_; }
+    [[nodiscard]] const physics::ContactEventQueue<GameObject*>& contact_events() const { return contact_events_; }
+    [[nodiscard]] std::uint64_t step_hash() const { return step_hash_; }
+    [[nodiscard]] physics::Stats& stats() { return stats_; }
+
+    void set_gravity(const math::Vec2f gravity) { gravity_ = gravity; }
+
+    void RegisterObject(GameObject& object);
+    void UnregisterObject(GameObject& object);
+
+    //One fixed step of the objects, integrate(substep_time) moves them and keeps their colliders in place
+    template <typename IntegrateFunction>
+    void Step(const std::span<GameObject> objects, const float delta_time, IntegrateFunction&& integrate)
+    {
+        PROFILE_ZONE();
+        //A paused scene does not step, the position solver divides by the step time
+        if (delta_time <= 0.0f)
+        {
+            return;
+        }
+
+        stats_.BeginStep();
+        //The broad phase runs once per step, its pairs are reused by every substep
+        {
+            physics::ScopedPhaseTimer timer(stats_, physics::Phase::kBroadPhase);
+            PredictMotion(objects, delta_time);
+            BroadPhase(objects);
+            OrderPairs();
+        }
+        stats_.step.candidate_pairs = static_cast<std::uint32_t>(pair_order_.size());
+
+        const int substep_count = solver_settings_.SubstepCount();
+        const float substep_time = delta_time / static_cast<float>(substep_count);
+        for (int i = 0; i < substep_count; ++i)
+        {
+            {
+                physics::ScopedPhaseTimer timer(stats_, physics::Phase::kIntegrate);
+                integrate(substep_time);
+            }
+            {
+                physics::ScopedPhaseTimer timer(stats_, physics::Phase::kContinuousCollision);
+                ContinuousCollisionPhase(substep_time);
+            }
+            {
+                physics::ScopedPhaseTimer timer(stats_, physics::Phase::kNarrowPhase);
+                NarrowPhase();
+            }
+            {
+                physics::ScopedPhaseTimer timer(stats_, physics::Phase::kSolve);
+                SolveContacts(substep_time);
+            }
+        }
+
+        {
+            physics::ScopedPhaseTimer timer(stats_, physics::Phase::kEvents);
+            UpdatePairEvents();
+
+            if (solver_settings_.deterministic)
+            {
+                HashState(objects);
+            }
+        }
+        stats_.EndStep();
+
+        PROFILE_PLOT("bodies", objects.size());
+        PROFILE_PLOT("pairs", potential_pairs_.size());
+    }
+
+    void PredictMotion(std::span<GameObject> objects, float delta_time);
+    void SimplisticBroadPhase(std::span<GameObject> objects);
+    void BroadPhase(std::span<GameObject> objects);
+    void OrderPairs();
+    void ContinuousCollisionPhase(float delta_time);
+    void NarrowPhase();
+    void SolveContacts(float delta_time);
+    void UpdatePairEvents();
+    void HashState(std::span<const GameObject> objects);
+
+    //Calls the game object callbacks of the recorded events, once after the fixed steps, then empties the queue
+    void DispatchContactEvents();
+};
+
+#endif //KUMA_ENGINE_API_PHYSICS_WORLD_H_
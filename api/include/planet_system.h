@@ -1,10 +1,12 @@
 ﻿#ifndef KUMA_ENGINE_API_PLANET_SYSTEM_H_
 #define KUMA_ENGINE_API_PLANET_SYSTEM_H_
 
+#include <span>
 #include <vector>
 
 #include "body.h"
 #include "game_object.h"
+#include "stats.h"
 #include "vec2.h"
 
 class PlanetSystem
@@ -12,6 +14,7 @@ class PlanetSystem
 private:
     static constexpr float kGravitationConstant_ = 0.0667f;
     static constexpr std::size_t kStartingPlanetsCount_ = 20;
+    std::size_t starting_planets_count_ = kStartingPlanetsCount_;
 
     float star_mass_ = 10.f;
     float planet_mass_ = 3.f;
@@ -20,6 +23,7 @@ private:
     std::vector<GameObject> planets_{};
 
     bool is_spawner_active_ = false;
+    physics::Stats stats_{}; //Time and work of the steps, filled every step
 
 public:
     PlanetSystem() = default;
@@ -34,8 +38,13 @@ public:
     void UpdatePlanetsSIMD(float delta_time);
     void SpawnPlanets(SDL_Color colour);
 
-    std::vector<GameObject> planets() { return planets_; }
+    //Live storage of the planets, read in place, valid until planets are added or removed
+    [[nodiscard]] std::span<GameObject> planets() { return planets_; }
+    [[nodiscard]] std::span<const GameObject> planets() const { return planets_; }
     physics::Body* star() { return &star_; }
+    [[nodiscard]] physics::Stats& stats() { return stats_; }
+    //Number of planets created by the next Initialize
+    void set_planet_count(const std::size_t count) { starting_planets_count_ = count; }
 
     void ToggleSpawner() { is_spawner_active_ = !is_spawner_active_; };
 };
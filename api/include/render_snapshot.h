@@ -0,0 +1,47 @@
+#ifndef KUMA_ENGINE_API_RENDER_SNAPSHOT_H_
+#define KUMA_ENGINE_API_RENDER_SNAPSHOT_H_
+
+#include <SDL_pixels.h>
+
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+#include "bounds2.h"
+#include "shape.h"
+#include "vec2.h"
+
+//What the renderer needs of a shape, copied out of the scene at the end of a step
+struct RenderShape
+{
+    math::ShapeType type = math::ShapeType::kCircle;
+    math::Vec2f position = math::Vec2f::Zero(); //Centre of circles and polygons, min bound of AABBs
+    math::Vec2f max_bound = math::Vec2f::Zero(); //AABBs only
+    math::Vec2f step_start_offset = math::Vec2f::Zero(); //Moves the shape back to where it was at the start of the step
+    float radius = 0.0f;
+    float orientation = 0.0f;
+    float step_start_orientation = 0.0f;
+    bool rotation = false; //Circles show their orientation
+    SDL_Color color{};
+    std::uint32_t first_vertex = 0; //Polygon vertices, in RenderSnapshot::polygon_vertices
+    std::uint32_t vertex_count = 0;
+};
+
+//State of the selected scene after a physics step, written by the physics thread and drawn by the render thread
+struct RenderSnapshot
+{
+    std::vector<RenderShape> shapes;
+    std::vector<math::Vec2f> polygon_vertices;
+    std::vector<math::Bounds2f> quadtree_nodes;
+    std::chrono::steady_clock::time_point step_end{}; //The frames interpolate from the time the step was published
+
+    //Keeps the capacity, the snapshots of a triple buffer are refilled every step
+    void Clear()
+    {
+        shapes.clear();
+        polygon_vertices.clear();
+        quadtree_nodes.clear();
+    }
+};
+
+#endif // KUMA_ENGINE_API_RENDER_SNAPSHOT_H_
@@ -1,21 +1,54 @@
 ﻿#ifndef KUMA_ENGINE_API_TRIGGER_SYSTEM_H_
 #define KUMA_ENGINE_API_TRIGGER_SYSTEM_H_
 
+#include <span>
 #include <unordered_map>
 #include <unordered_set>
+#include <vector>
 
+#include "display.h"
 #include "game_object.h"
 #include "quadtree.h"
+#include "stats.h"
+
+enum class TriggerEventType
+{
+    kBegin,
+    kEnd
+};
+
+//Overlap change of a pair, recorded during the step and handed to the game afterwards
+struct TriggerEvent
+{
+    GameObjectPair pair;
+    TriggerEventType type;
+};
 
 class TriggerSystem
 {
 private:
-    int number_of_objects_ = 400;
-    std::array<GameObject, 400> objects_ = {};
+    static constexpr std::size_t kDefaultObjectCount = 400;
+
+    std::size_t number_of_objects_ = kDefaultObjectCount;
+    //Sized once by Initialize, so the object addresses held by the pairs stay valid
+    std::vector<GameObject> objects_;
+    //Area the objects are spawned in and bounce inside of
+    math::Bounds2f world_bounds_ = math::Bounds2f(math::Vec2f(0, 0), math::Vec2f(kWindowWidth, kWindowHeight));
     physics::Quadtree* quadtree_ = nullptr;
 
     std::unordered_map<GameObjectPair, bool> potential_pairs_;
+    std::vector<physics::Collider*> query_results_; //Reused by every quadtree query of the broad phase
     std::unordered_set<GameObjectPair> active_pairs_;
+    std::unordered_set<GameObjectPair> overlapping_pairs_;
+
+    //Pairs grouped by shape types for the batched overlap tests, circle and box pairs keep the box first
+    std::vector<GameObjectPair> circle_pairs_;
+    std::vector<GameObjectPair> aabb_pairs_;
+    std::vector<GameObjectPair> aabb_circle_pairs_;
+
+    //Begin and end events of the steps since the last dispatch
+    std::vector<TriggerEvent> trigger_events_;
+    physics::Stats stats_{}; //Time and work of the steps, filled every step
 
     //Mapping from Collider to GameObject
     std::unordered_map<physics::Collider*, GameObject*> collider_to_object_map_;
@@ -27,8 +60,16 @@ public:
     void Initialize();
     void Clear();
 
-    std::array<GameObject, 400> objects() { return objects_; }
+    //Live storage of the scene, read in place, valid until objects are added or removed
+    [[nodiscard]] std::span<GameObject> objects() { return objects_; }
+    [[nodiscard]] std::span<const GameObject> objects() const { return objects_; }
+    //Number of objects created by the next Initialize
+    void set_object_count(const std::size_t count) { number_of_objects_ = count; }
+    //Bounds used by the next Initialize, larger scenes keep their density in a larger world
+    void set_world_bounds(const math::Bounds2f& bounds) { world_bounds_ = bounds; }
     [[nodiscard]] physics::Quadtree* quadtree() const { return quadtree_; }
+    [[nodiscard]] const std::vector<TriggerEvent>& trigger_events() const { return trigger_events_; }
+    [[nodiscard]] physics::Stats& stats() { return stats_; }
 
     void CreateObject(size_t index, math::Circle& circle);
     void CreateObject(size_t index, math::AABB& aabb);
@@ -45,9 +86,8 @@ public:
     void BroadPhase();
     void NarrowPhase();
 
-    static void OnPairCollideStart(const GameObjectPair& pair);
-    static void OnPairCollideStay(const GameObjectPair& pair);
-    static void OnPairCollideEnd(const GameObjectPair& pair);
+    //Calls the game object callbacks of the recorded events, once after the fixed steps, then empties the buffer
+    void DispatchTriggerEvents();
 };
 
 
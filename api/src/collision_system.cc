@@ -1,30 +1,32 @@
 ﻿#include "collision_system.h"
 
-#include <ranges>
-
-#include "contact_solver.h"
 #include "display.h"
+#include "profiler.h"
 #include "random.h"
 
 void CollisionSystem::Initialize()
 {
     Clear();
 
-    quadtree_ = new physics::Quadtree(math::AABB(math::Vec2f(0, 0),  math::Vec2f(kWindowWidth, kWindowHeight)));
+    world_.Initialize(world_bounds_);
     constexpr float margin = 20.0f;
 
-    for (size_t i = 0; i < number_of_objects_ / 2 - 1; i++)
+    objects_.assign(number_of_objects_, {});
+    const std::size_t circle_count = number_of_objects_ > 1 ? number_of_objects_ / 2 - 1 : number_of_objects_;
+    for (size_t i = 0; i < circle_count; i++)
     {
-        const math::Vec2f position(random::Range(margin, kWindowWidth - margin), random::Range(margin, kWindowHeight - margin));
-        const float radius = random::Range(5.f, 10.f);
+        const math::Vec2f position(common::rng::Range(world_bounds_.min_bound().x + margin, world_bounds_.max_bound().x - margin),
+                                   common::rng::Range(world_bounds_.min_bound().y + margin, world_bounds_.max_bound().y - margin));
+        const float radius = common::rng::Range(5.f, 10.f);
 
         math::Circle circle(position, radius);
         CreateObject(i, circle);
     }
-    for (size_t i = number_of_objects_ / 2 - 1; i < number_of_objects_; i++)
+    for (size_t i = circle_count; i < number_of_objects_; i++)
     {
-        const math::Vec2f position(random::Range(margin, kWindowWidth - margin), random::Range(margin, kWindowHeight - margin));
-        math::Vec2f half_size_vec = math::Vec2f(random::Range(5.f, 10.f),random::Range(5.f, 10.f));
+        const math::Vec2f position(common::rng::Range(world_bounds_.min_bound().x + margin, world_bounds_.max_bound().x - margin),
+                                   common::rng::Range(world_bounds_.min_bound().y + margin, world_bounds_.max_bound().y - margin));
+        math::Vec2f half_size_vec = math::Vec2f(common::rng::Range(5.f, 10.f),common::rng::Range(5.f, 10.f));
         auto half_size_length = half_size_vec.Magnitude();
 
         math::AABB aabb(position, half_size_vec, half_size_length);
@@ -34,30 +36,17 @@ void CollisionSystem::Initialize()
 
 void CollisionSystem::Clear()
 {
-    if (quadtree_)
-    {
-        quadtree_->Clear();
-        delete quadtree_;
-        quadtree_ = nullptr;
-    }
-
-    for (size_t i = 0; i < number_of_objects_; ++i)
-    {
-        DeleteObject(i);
-    }
-
-    objects_.fill({});
-    potential_pairs_.clear();
-    active_pairs_.clear();
-    collider_to_object_map_.clear();
+    //The world drops every pair and registration at once, the objects need no one by one removal
+    world_.Clear();
+    objects_.clear();
 }
 
 
 void CollisionSystem::CreateObject(size_t index, math::Circle& circle)
 {
-    math::Vec2f velocity(random::Range(-50.0f, 50.0f), random::Range(-50.0f, 50.0f));
-    physics::Body body(physics::BodyType::Dynamic,circle.centre(), velocity, random::Range(1.0f, 50.0f));
-    physics::Collider collider(circle, random::Range(1.0f, 1.0f), 0, false);
+    math::Vec2f velocity(common::rng::Range(-50.0f, 50.0f), common::rng::Range(-50.0f, 50.0f));
+    physics::Body body(physics::BodyType::Dynamic,circle.centre(), velocity, common::rng::Range(1.0f, 50.0f));
+    physics::Collider collider(circle, common::rng::Range(1.0f, 1.0f), 0, false);
     GameObject object(body, collider, circle.radius());
 
     objects_[index] = object;
@@ -66,9 +55,9 @@ void CollisionSystem::CreateObject(size_t index, math::Circle& circle)
 
 void CollisionSystem::CreateObject(size_t index, math::AABB& aabb)
 {
-    math::Vec2f velocity(random::Range(-50.0f, 50.0f), random::Range(-50.0f, 50.0f));
-    physics::Body body(physics::BodyType::Dynamic, aabb.GetCentre(), velocity, random::Range(1.0f, 50.0f));
-    physics::Collider collider(aabb, random::Range(1.0f, 1.0f), 0, false);
+    math::Vec2f velocity(common::rng::Range(-50.0f, 50.0f), common::rng::Range(-50.0f, 50.0f));
+    physics::Body body(physics::BodyType::Dynamic, aabb.GetCentre(), velocity, common::rng::Range(1.0f, 50.0f));
+    physics::Collider collider(aabb, common::rng::Range(1.0f, 1.0f), 0, false);
     GameObject object(body, collider, aabb.half_size_length());
 
     objects_[index] = object;
@@ -86,23 +75,22 @@ void CollisionSystem::DeleteObject(size_t index)
 
 void CollisionSystem::RegisterObject(GameObject& object)
 {
-    collider_to_object_map_[&object.collider()] = &object;
+    world_.RegisterObject(object);
 }
 
 void CollisionSystem::UnregisterObject(GameObject& object)
 {
-    collider_to_object_map_.erase(&object.collider());
+    world_.UnregisterObject(object);
 }
 
-void CollisionSystem::Update(float delta_time)
+void CollisionSystem::Update(const float delta_time)
 {
-    UpdateShapes(delta_time);
-    BroadPhase();
-    NarrowPhase();
+    world_.Step(objects_, delta_time, [this](const float substep_time) { UpdateShapes(substep_time); });
 }
 
 void CollisionSystem::UpdateShapes(float delta_time)
 {
+    PROFILE_ZONE();
     for (auto& object : objects_)
     {
         auto& body = object.body();
@@ -114,221 +102,36 @@ void CollisionSystem::UpdateShapes(float delta_time)
 
         float radius = object.radius();
 
-        //Check for collision with window borders
-        if (position.x - radius < 0)
+        //Check for collision with the world borders
+        if (position.x - radius < world_bounds_.min_bound().x)
         {
-            position.x = radius;
+            position.x = world_bounds_.min_bound().x + radius;
             body.set_velocity(math::Vec2f(-body.velocity().x, body.velocity().y));
         }
-        if(position.x + radius > 1200)
+        if(position.x + radius > world_bounds_.max_bound().x)
         {
-            position.x = 1200 - radius;
+            position.x = world_bounds_.max_bound().x - radius;
             body.set_velocity(math::Vec2f(-body.velocity().x, body.velocity().y));
         }
-        if (position.y - radius < 0)
+        if (position.y - radius < world_bounds_.min_bound().y)
         {
-            position.y = radius;
+            position.y = world_bounds_.min_bound().y + radius;
             body.set_velocity(math::Vec2f(body.velocity().x, -body.velocity().y));
         }
-        if(position.y + radius > 800)
+        if(position.y + radius > world_bounds_.max_bound().y)
         {
-            position.y = 800 - radius;
+            position.y = world_bounds_.max_bound().y - radius;
             body.set_velocity(math::Vec2f(body.velocity().x, -body.velocity().y));
         }
 
-        //Update the collider's position
+        //Update the body and collider's position
+        body.set_position(position);
         collider.UpdatePosition(position);
-    }
-}
-
-void CollisionSystem::SimplisticBroadPhase()
-{
-    std::unordered_map<GameObjectPair, bool> new_potential_pairs;
 
-    // Loop through all objects
-    for (size_t i = 0; i < objects_.size(); ++i)
-    {
-        auto& objectA = objects_[i];
-        auto& colliderA = objectA.collider();
-
-        // Get the AABB of the first collider
-        auto rangeA = colliderA.GetBoundingBox();
-
-        // Compare with all other objects
-        for (size_t j = i + 1; j < objects_.size(); ++j)
-        {
-            auto& objectB = objects_[j];
-            auto& colliderB = objectB.collider();
-
-            // Get the AABB of the second collider
-            auto rangeB = colliderB.GetBoundingBox();
-
-            // Check for AABB overlap
-            if (math::Intersect(rangeA, rangeB))
-            {
-                GameObjectPair pair{&objectA, &objectB};
-                new_potential_pairs[pair] = true;
-            }
-        }
     }
-
-    // Update the potential pairs for narrow phase to process
-    potential_pairs_ = std::move(new_potential_pairs);
 }
 
-
-
-void CollisionSystem::BroadPhase()
+void CollisionSystem::DispatchContactEvents()
 {
-    std::unordered_map<GameObjectPair, bool> new_potential_pairs;
-
-    quadtree_->Clear();
-    for (auto& object : objects_)
-    {
-        quadtree_->Insert(&object.collider());
-    }
-
-    // Use AABB tests for broad phase
-    for (auto& object : objects_)
-    {
-        auto& collider = object.collider();
-        // Get the AABB of the collider for broad phase test
-        auto range = collider.GetBoundingBox();
-        auto potentialColliders = quadtree_->Query(range);
-
-        for (auto& otherCollider : potentialColliders)
-        {
-            if (&collider != otherCollider)
-            {
-                // Avoid self-collision
-                // Only test AABB overlap in broad phase
-                if (math::Intersect(range, otherCollider->GetBoundingBox()))
-                {
-                    GameObject* objectA = collider_to_object_map_[&collider];
-                    GameObject* objectB = collider_to_object_map_[otherCollider];
-                    if (objectA && objectB)
-                    {
-                        GameObjectPair pair{objectA, objectB};
-                        new_potential_pairs[pair] = true;
-                    }
-                }
-            }
-        }
-    }
-
-    // Update the potential pairs for narrow phase to process
-    potential_pairs_ = std::move(new_potential_pairs);
+    world_.DispatchContactEvents();
 }
-
-void CollisionSystem::NarrowPhase()
-{
-    std::unordered_set<GameObjectPair> newActivePairs;
-
-    for (const auto& pair : potential_pairs_ | std::views::keys)
-    {
-        if (!pair.gameObjectA_ || !pair.gameObjectB_)
-        {
-            continue;
-        }
-
-        bool intersect = std::visit([](auto&& shape_a, auto&& shape_b)
-                                    {
-                                        return math::Intersect(shape_a, shape_b);
-                                    }, pair.gameObjectA_->collider().shape(),
-                                    pair.gameObjectB_->collider().shape());
-
-        if (intersect)
-        {
-            newActivePairs.insert(pair);
-
-            // If this is a new collision Keep for triggers?
-            if (active_pairs_.find(pair) == active_pairs_.end())
-            {
-                OnPairCollideStart(pair);
-            }
-            else
-            {
-                OnPairCollideStay(pair);
-            }
-        }
-    }
-
-    for (const auto& pair : active_pairs_)
-    {
-        if (newActivePairs.find(pair) == newActivePairs.end())
-        {
-            OnPairCollideEnd(pair);
-        }
-    }
-    active_pairs_ = std::move(newActivePairs);
-}
-
-//Called on the first collision frame
-void CollisionSystem::OnPairCollideStart(const GameObjectPair& pair)
-{
-    if(!pair.gameObjectA_ || !pair.gameObjectB_){return;}
-
-    pair.gameObjectA_->AddCollision();
-    pair.gameObjectB_->AddCollision();
-
-    if (pair.gameObjectA_->collider().is_trigger() || pair.gameObjectB_->collider().is_trigger())
-    {
-        pair.gameObjectA_->OnTriggerEnter();
-        pair.gameObjectB_->OnTriggerEnter();
-    }
-    else
-    {
-        physics::ContactSolver ContactSolver;
-        ContactSolver.SetContactObjects(pair);
-        ContactSolver.ResolveContact();
-        pair.gameObjectA_->OnCollisionEnter();
-        pair.gameObjectB_->OnCollisionEnter();
-    }
-}
-void CollisionSystem::OnPairCollideStay(const GameObjectPair& pair)
-{
-    if(!pair.gameObjectA_ || !pair.gameObjectB_){return;}
-
-    if (pair.gameObjectA_->collider().is_trigger() || pair.gameObjectB_->collider().is_trigger())
-    {
-        pair.gameObjectA_->OnTriggerStay();
-        pair.gameObjectB_->OnTriggerStay();
-    }
-    else
-    {
-        //pair.gameObjectA_->OnCollisionStay();
-        //pair.gameObjectB_->OnCollisionStay();
-    }
-}
-
-void CollisionSystem::OnPairCollideEnd(const GameObjectPair& pair)
-{
-    if (!pair.gameObjectA_ || !pair.gameObjectB_) return;
-
-    pair.gameObjectA_->SubCollision();
-    pair.gameObjectB_->SubCollision();
-
-    if (pair.gameObjectA_->collider().is_trigger() || pair.gameObjectB_->collider().is_trigger())
-    {
-        if (pair.gameObjectA_->collisions_count() <= 0)
-        {
-            pair.gameObjectA_->OnTriggerExit();
-        }
-        if (pair.gameObjectB_->collisions_count() <= 0)
-        {
-            pair.gameObjectB_->OnTriggerExit();
-        }
-    }
-    else
-    {
-
-        if (pair.gameObjectA_->collisions_count() <= 0)
-        {
-            pair.gameObjectA_->OnCollisionExit();
-        }
-        if (pair.gameObjectB_->collisions_count() <= 0)
-        {
-            pair.gameObjectB_->OnCollisionExit();
-        }
-    }
-}
\ No newline at end of file
@@ -1,12 +1,19 @@
 ﻿#include "friction_system.h"
 
+#include <algorithm>
+#include <array>
 #include <iostream>
-#include <ranges>
+#include <numbers>
+#include <span>
 
-#include "contact_solver.h"
 #include "metrics.h"
+#include "profiler.h"
 #include "random.h"
 
+namespace
+{
+    constexpr math::Vec2f kGravity = metrics::ConvertToPixels(math::Vec2f(0.f, 9.8f));
+}
 
 FrictionSystem::~FrictionSystem()
 {
@@ -16,36 +23,35 @@ FrictionSystem::~FrictionSystem()
 void FrictionSystem::Initialize()
 {
     Clear();
-    quadtree_ = new physics::Quadtree(math::AABB(math::Vec2f(0, 0), math::Vec2f(1200, 800)));
+    world_.Initialize(math::Bounds2f(math::Vec2f(0, 0), math::Vec2f(1200, 800)));
+    world_.set_gravity(kGravity);
     timer_ = new Timer();
-    objects_.reserve(1000);
+    objects_.reserve(object_capacity_);
     CreateGround();
 }
 
 void FrictionSystem::Clear()
 {
-    if (quadtree_)
-    {
-        quadtree_->Clear();
-        delete quadtree_;
-        quadtree_ = nullptr;
-    }
+    world_.Clear();
 
     delete timer_;
     timer_ = nullptr;
 
     objects_.clear();
-    potential_pairs_.clear();
-    active_pairs_.clear();
-    collider_to_object_map_.clear();
 }
 
 
 void FrictionSystem::SpawnShape(const math::Vec2f pos, const math::ShapeType type)
 {
+    //Growing the storage would move the objects the pairs point to
+    if (objects_.size() == objects_.capacity())
+    {
+        return;
+    }
+
     const size_t i = objects_.size();
     math::Vec2f new_position = pos;
-    const float radius = random::Range(5.f, 20.f);
+    const float radius = common::rng::Range(5.f, 20.f);
 
     constexpr int max_retries = 10; // Limit retries to avoid infinite loops.
     for (int retry = 0; retry < max_retries; ++retry)
@@ -54,8 +60,8 @@ void FrictionSystem::SpawnShape(const math::Vec2f pos, const math::ShapeType typ
         for (auto& object : objects_)
         {
             if (math::Intersect(object.collider().GetBoundingBox(),
-                                math::AABB(new_position - math::Vec2f(radius, radius),
-                                           new_position + math::Vec2f(radius, radius))))
+                                math::Bounds2f(new_position - math::Vec2f(radius, radius),
+                                               new_position + math::Vec2f(radius, radius))))
             {
                 position_valid = false;
                 new_position.y = object.collider().GetBoundingBox().min_bound().y - radius - 2.0f; // Move down slightly and retry.
@@ -70,7 +76,7 @@ void FrictionSystem::SpawnShape(const math::Vec2f pos, const math::ShapeType typ
     {
     case math::ShapeType::kAABB:
         {
-            const float half_size_x = random::Range(5.f, 20.f);
+            const float half_size_x = common::rng::Range(5.f, 20.f);
             const float half_size_y = radius;
             const auto half_size_vec = math::Vec2f(half_size_x, half_size_y);
             const auto half_size_length = half_size_vec.Magnitude();
@@ -85,6 +91,20 @@ void FrictionSystem::SpawnShape(const math::Vec2f pos, const math::ShapeType typ
         }
         break;
     case math::ShapeType::kPolygon:
+        {
+            //Regular convex polygon with a random number of sides, at a random orientation
+            const int vertex_count = common::rng::Range(3, 8);
+            const float angle_offset = common::rng::Range(0.f, 2.f * std::numbers::pi_v<float>);
+            std::array<math::Vec2f, math::kMaxPolygonVertices> vertices{};
+            for (int v = 0; v < vertex_count; ++v)
+            {
+                const float angle = angle_offset + 2.f * std::numbers::pi_v<float> * static_cast<float>(v) / static_cast<float>(vertex_count);
+                vertices[v] = math::Vec2f(std::cos(angle) * radius, std::sin(angle) * radius);
+            }
+            math::Polygon polygon(std::span<const math::Vec2f>(vertices.data(), vertex_count), new_position, 0.0f);
+            CreateObject(i, polygon);
+        }
+        break;
     case math::ShapeType::kNone:
     default:
         break;
@@ -94,8 +114,10 @@ void FrictionSystem::SpawnShape(const math::Vec2f pos, const math::ShapeType typ
 void FrictionSystem::CreateObject(size_t index, math::Circle& circle)
 {
     math::Vec2f velocity(0.0f, 0.0f);
-    physics::Body body(physics::BodyType::Dynamic, circle.centre(), velocity, random::Range(50.f, 100.f));
-    physics::Collider collider(circle, random::Range(0.5f, 0.9f), 0.1f, false);
+    physics::Body body(physics::BodyType::Dynamic, circle.centre(), velocity, common::rng::Range(50.f, 100.f));
+    physics::Collider collider(circle, common::rng::Range(0.5f, 0.9f), 0.1f, false);
+    //Circles roll on contact, AABBs keep a fixed rotation since their collider is axis-aligned
+    body.set_inertia(collider.CalculateInertia(body.mass()));
     GameObject object(body, collider, circle.radius());
 
     objects_.push_back(object);
@@ -105,14 +127,27 @@ void FrictionSystem::CreateObject(size_t index, math::Circle& circle)
 void FrictionSystem::CreateObject(size_t index, math::AABB& aabb)
 {
     math::Vec2f velocity(0.0f, 0.0f);
-    physics::Body body(physics::BodyType::Dynamic, aabb.GetCentre(), velocity, random::Range(50.f, 100.f));
-    physics::Collider collider(aabb, random::Range(0.0f, 0.0f), 0.5f, false);
+    physics::Body body(physics::BodyType::Dynamic, aabb.GetCentre(), velocity, common::rng::Range(50.f, 100.f));
+    physics::Collider collider(aabb, common::rng::Range(0.0f, 0.0f), 0.5f, false);
     GameObject object(body, collider, aabb.half_size_length());
 
     objects_.push_back(object);
     RegisterObject(objects_[index]);
 }
 
+void FrictionSystem::CreateObject(size_t index, math::Polygon& polygon)
+{
+    math::Vec2f velocity(0.0f, 0.0f);
+    physics::Body body(physics::BodyType::Dynamic, polygon.position(), velocity, common::rng::Range(50.f, 100.f));
+    physics::Collider collider(polygon, common::rng::Range(0.0f, 0.3f), 0.5f, false);
+    //Polygons rotate around their centroid
+    body.set_inertia(collider.CalculateInertia(body.mass()));
+    GameObject object(body, collider, polygon.GetBoundingBox().half_size_length());
+
+    objects_.push_back(object);
+    RegisterObject(objects_[index]);
+}
+
 void FrictionSystem::CreateGround()
 {
     size_t i = objects_.size();
@@ -158,248 +193,37 @@ void FrictionSystem::RemoveOutOfBoundsObjects()
 
 void FrictionSystem::RegisterObject(GameObject& object)
 {
-    collider_to_object_map_[&object.collider()] = &object;
+    world_.RegisterObject(object);
 }
 
 void FrictionSystem::UnregisterObject(GameObject& object)
 {
-    const auto collider = &object.collider();
-
-    // Remove collider from collider_to_object_map_
-    collider_to_object_map_.erase(collider);
-
-    // Remove related pairs in active_pairs_ and potential_pairs_
-    for (auto it = active_pairs_.begin(); it != active_pairs_.end();)
-    {
-        if (it->gameObjectA_ == &object || it->gameObjectB_ == &object)
-            it = active_pairs_.erase(it);
-        else
-            ++it;
-    }
-
-    for (auto it = potential_pairs_.begin(); it != potential_pairs_.end();)
-    {
-        if (it->first.gameObjectA_ == &object || it->first.gameObjectB_ == &object)
-            it = potential_pairs_.erase(it);
-        else
-            ++it;
-    }
+    world_.UnregisterObject(object);
 }
 
 
 void FrictionSystem::Update(const float delta_time)
 {
-        UpdateShapes(delta_time);
-        //RemoveOutOfBoundsObjects();
-        BroadPhase();
-        NarrowPhase();
+    world_.Step(objects_, delta_time, [this](const float substep_time) { UpdateShapes(substep_time); });
 }
 
 void FrictionSystem::UpdateShapes(const float delta_time)
 {
+    PROFILE_ZONE();
     for (auto& object : objects_)
     {
         auto& body = object.body();
         auto& collider = object.collider();
-        constexpr math::Vec2f gravity = metrics::ConvertToPixels(math::Vec2f(0.f, 9.8f));
-
-        body.ApplyGravity(gravity);
+        body.ApplyGravity(kGravity);
 
         body.Update(delta_time);
 
-        const auto position = body.position();
-
-        //Update the collider's position
-        collider.UpdatePosition(position);
+        //Update the collider's position and orientation
+        collider.UpdateTransform(body.position(), body.orientation());
     }
 }
 
-void FrictionSystem::SimplisticBroadPhase()
+void FrictionSystem::DispatchContactEvents()
 {
-    std::unordered_map<GameObjectPair, bool> new_potential_pairs;
-
-    // Loop through all objects
-    for (size_t i = 0; i < objects_.size(); ++i)
-    {
-        auto& objectA = objects_[i];
-        auto& colliderA = objectA.collider();
-
-        // Get the AABB of the first collider
-        auto rangeA = colliderA.GetBoundingBox();
-
-        // Compare with all other objects
-        for (size_t j = i + 1; j < objects_.size(); ++j)
-        {
-            auto& objectB = objects_[j];
-            auto& colliderB = objectB.collider();
-
-            // Get the AABB of the second collider
-            auto rangeB = colliderB.GetBoundingBox();
-
-            // Check for AABB overlap
-            if (math::Intersect(rangeA, rangeB))
-            {
-                GameObjectPair pair{&objectA, &objectB};
-                new_potential_pairs[pair] = true;
-            }
-        }
-    }
-
-    // Update the potential pairs for narrow phase to process
-    potential_pairs_ = std::move(new_potential_pairs);
+    world_.DispatchContactEvents();
 }
-
-void FrictionSystem::BroadPhase()
-{
-    std::unordered_map<GameObjectPair, bool> new_potential_pairs;
-
-    quadtree_->Clear();
-    for (auto& object : objects_)
-    {
-        quadtree_->Insert(&object.collider());
-    }
-
-    // Use AABB tests for broad phase
-    for (auto& object : objects_)
-    {
-        auto& collider = object.collider();
-        // Get the AABB of the collider for broad phase test
-        auto range = collider.GetBoundingBox();
-        auto potentialColliders = quadtree_->Query(range);
-
-        for (auto& otherCollider : potentialColliders)
-        {
-            if (&collider != otherCollider)
-            {
-                // Avoid self-collision
-                // Only test AABB overlap in broad phase
-                if (math::Intersect(range, otherCollider->GetBoundingBox()))
-                {
-                    GameObject* objectA = collider_to_object_map_[&collider];
-                    GameObject* objectB = collider_to_object_map_[otherCollider];
-                    if (objectA && objectB)
-                    {
-                        GameObjectPair pair{objectA, objectB};
-                        new_potential_pairs[pair] = true;
-                    }
-                }
-            }
-        }
-    }
-
-    // Update the potential pairs for narrow phase to process
-    potential_pairs_ = std::move(new_potential_pairs);
-}
-
-void FrictionSystem::NarrowPhase()
-{
-    std::unordered_set<GameObjectPair> newActivePairs;
-
-    for (const auto& pair : potential_pairs_ | std::views::keys)
-    {
-        if (!pair.gameObjectA_ || !pair.gameObjectB_)
-        {
-            continue;
-        }
-
-        const bool intersect = std::visit([](auto&& shape_a, auto&& shape_b)
-                                          {
-                                              return math::Intersect(shape_a, shape_b);
-                                          }, pair.gameObjectA_->collider().shape(),
-                                          pair.gameObjectB_->collider().shape());
-
-        if (intersect)
-        {
-            newActivePairs.insert(pair);
-
-            // If this is a new collision Keep for triggers?
-            if (active_pairs_.find(pair) == active_pairs_.end())
-            {
-                OnPairCollideStart(pair);
-            }
-            else
-            {
-                OnPairCollideStay(pair);
-            }
-        }
-    }
-
-    for (const auto& pair : active_pairs_)
-    {
-        if (newActivePairs.find(pair) == newActivePairs.end())
-        {
-            OnPairCollideEnd(pair);
-        }
-    }
-    active_pairs_ = std::move(newActivePairs);
-}
-
-//Called on the first collision frame
-void FrictionSystem::OnPairCollideStart(const GameObjectPair& pair)
-{
-    if(!pair.gameObjectA_ || !pair.gameObjectB_){return;}
-
-    pair.gameObjectA_->AddCollision();
-    pair.gameObjectB_->AddCollision();
-
-    if (pair.gameObjectA_->collider().is_trigger() || pair.gameObjectB_->collider().is_trigger())
-    {
-        pair.gameObjectA_->OnTriggerEnter();
-        pair.gameObjectB_->OnTriggerEnter();
-    }
-    else
-    {
-        physics::ContactSolver ContactSolver;
-        ContactSolver.SetContactObjects(pair);
-        ContactSolver.ResolveContact();
-        pair.gameObjectA_->OnCollisionEnter();
-        pair.gameObjectB_->OnCollisionEnter();
-    }
-}
-void FrictionSystem::OnPairCollideStay(const GameObjectPair& pair)
-{
-    if(!pair.gameObjectA_ || !pair.gameObjectB_){return;}
-
-    if (pair.gameObjectA_->collider().is_trigger() || pair.gameObjectB_->collider().is_trigger())
-    {
-        pair.gameObjectA_->OnTriggerStay();
-        pair.gameObjectB_->OnTriggerStay();
-    }
-    else
-    {
-        //pair.gameObjectA_->OnCollisionStay();
-        //pair.gameObjectB_->OnCollisionStay();
-    }
-}
-
-void FrictionSystem::OnPairCollideEnd(const GameObjectPair& pair)
-{
-    if (!pair.gameObjectA_ || !pair.gameObjectB_) return;
-
-    pair.gameObjectA_->SubCollision();
-    pair.gameObjectB_->SubCollision();
-
-    if (pair.gameObjectA_->collider().is_trigger() || pair.gameObjectB_->collider().is_trigger())
-    {
-        if (pair.gameObjectA_->collisions_count() <= 0)
-        {
-            pair.gameObjectA_->OnTriggerExit();
-        }
-        if (pair.gameObjectB_->collisions_count() <= 0)
-        {
-            pair.gameObjectB_->OnTriggerExit();
-        }
-    }
-    else
-    {
-
-        if (pair.gameObjectA_->collisions_count() <= 0)
-        {
-            pair.gameObjectA_->OnCollisionExit();
-        }
-        if (pair.gameObjectB_->collisions_count() <= 0)
-        {
-            pair.gameObjectB_->OnCollisionExit();
-        }
-    }
-}
\ No newline at end of file
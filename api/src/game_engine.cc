@@ -1,11 +1,16 @@
-#include "game_engine.h"
+﻿#include "game_engine.h"
 
 #include <SDL_events.h>
 
+#include <algorithm>
+#include <chrono>
 #include <iostream>
 #include <ostream>
+#include <span>
+#include <utility>
 
 #include "imgui_interface.h"
+#include "profiler.h"
 #include "random.h"
 
 
@@ -25,6 +30,8 @@ GameEngine::GameEngine()
 
 GameEngine::~GameEngine()
 {
+    //The physics thread uses the scenes until it is joined
+    StopPhysicsThread();
     delete imgui_interface_;
     delete friction_system_;
     delete collision_system_;
@@ -34,7 +41,74 @@ GameEngine::~GameEngine()
     delete display_;
 }
 
+//A deterministic scene starts from the scene seed at every reset so it replays, the others get a new layout each time
+void GameEngine::SeedScene() const
+{
+    const physics::SolverSettings* settings = scene_solver_settings();
+    common::rng::Seed(settings && settings->deterministic ? scene_seed_ : common::rng::SystemSeed());
+}
+
+void GameEngine::Post(std::function<void()> command)
+{
+    //Without the physics thread the frames own the scenes and the change applies at once
+    if (!physics_thread_.joinable())
+    {
+        command();
+        return;
+    }
+    std::lock_guard lock(command_mutex_);
+    commands_.push_back(std::move(command));
+}
+
+void GameEngine::RunCommands()
+{
+    //The queue is swapped out so the frames can post while the commands run
+    {
+        std::lock_guard lock(command_mutex_);
+        running_commands_.swap(commands_);
+    }
+    for (auto& command : running_commands_)
+    {
+        command();
+    }
+    running_commands_.clear();
+}
+
 void GameEngine::ChangeScene(const SystemScene new_sample)
+{
+    Post([this, new_sample] { ResetScene(new_sample); });
+}
+
+void GameEngine::set_solver_settings(const physics::SolverSettings& settings)
+{
+    Post([this, settings]
+    {
+        if (physics::SolverSettings* scene_settings = scene_solver_settings())
+        {
+            //The load reduction belongs to the step budget, the panel only shows it
+            const int load_reduction = scene_settings->load_reduction;
+            *scene_settings = settings;
+            scene_settings->load_reduction = load_reduction;
+        }
+    });
+}
+
+void GameEngine::set_max_steps_per_frame(const int max_steps)
+{
+    Post([this, max_steps] { step_budget_.set_max_steps_per_frame(max_steps); });
+}
+
+void GameEngine::set_adaptive(const bool adaptive)
+{
+    Post([this, adaptive] { step_budget_.set_adaptive(adaptive); });
+}
+
+void GameEngine::set_scene_seed(const std::uint64_t seed)
+{
+    Post([this, seed] { scene_seed_ = seed; });
+}
+
+void GameEngine::ResetScene(const SystemScene new_sample)
 {
     // Perform cleanup for the current scene
     switch (selected_scene_) {
@@ -56,6 +130,10 @@ void GameEngine::ChangeScene(const SystemScene new_sample)
 
     //Update to the new scene
     selected_scene_ = new_sample;
+    step_budget_.ResetDropped();
+    stats_history_.Clear();
+
+    SeedScene();
 
     // Initialize the new scene
     switch (selected_scene_) {
@@ -97,30 +175,45 @@ void GameEngine::HandleEvents()
         }
         else if (event.type == SDL_MOUSEBUTTONDOWN && !ImGui::GetIO().WantCaptureMouse)
         {
+            //The clicks are posted, the scene they act on is checked when the command runs
+            int mouse_x, mouse_y;
+            SDL_GetMouseState(&mouse_x, &mouse_y);
+            const auto mouse_pos = math::Vec2f(static_cast<float>(mouse_x), static_cast<float>(mouse_y));
+
             if (event.button.button == SDL_BUTTON_LEFT)
             {
-                if (selected_scene_ == SystemScene::PlanetSystemScene)
+                Post([this, mouse_pos]
                 {
-                    // PLANET SYSTEM:
-                    planet_system_->ToggleSpawner();
-                }
-                if (selected_scene_ == SystemScene::FrictionSystemScene)
+                    if (selected_scene_ == SystemScene::PlanetSystemScene)
+                    {
+                        // PLANET SYSTEM:
+                        planet_system_->ToggleSpawner();
+                    }
+                    if (selected_scene_ == SystemScene::FrictionSystemScene)
+                    {
+                        friction_system_->SpawnShape(mouse_pos, math::ShapeType::kCircle);
+                    }
+                });
+            }
+            else if (event.button.button == SDL_BUTTON_RIGHT)
+            {
+                Post([this, mouse_pos]
                 {
-                    int mouse_x, mouse_y;
-                    SDL_GetMouseState(&mouse_x, &mouse_y);
-                    const auto mouse_pos = math::Vec2f(static_cast<float>(mouse_x), static_cast<float>(mouse_y));
-                    friction_system_->SpawnShape(mouse_pos, math::ShapeType::kCircle);
-                }
+                    if (selected_scene_ == SystemScene::FrictionSystemScene)
+                    {
+                        friction_system_->SpawnShape(mouse_pos, math::ShapeType::kAABB);
+                    }
+                });
             }
-            else if (event.button.button == SDL_BUTTON_RIGHT && !ImGui::GetIO().WantCaptureMouse)
+            else if (event.button.button == SDL_BUTTON_MIDDLE)
             {
-                if (selected_scene_ == SystemScene::FrictionSystemScene)
+                Post([this, mouse_pos]
                 {
-                    int mouse_x, mouse_y;
-                    SDL_GetMouseState(&mouse_x, &mouse_y);
-                    const auto mouse_pos = math::Vec2f(static_cast<float>(mouse_x), static_cast<float>(mouse_y));
-                    friction_system_->SpawnShape(mouse_pos, math::ShapeType::kAABB);
-                }
+                    if (selected_scene_ == SystemScene::FrictionSystemScene)
+                    {
+                        friction_system_->SpawnShape(mouse_pos, math::ShapeType::kPolygon);
+                    }
+                });
             }
         }
         // else if (event.type == SDL_MOUSEBUTTONUP)
@@ -132,130 +225,465 @@ void GameEngine::HandleEvents()
     }
 }
 
-void GameEngine::Run()
+void GameEngine::PostStepInputs()
 {
-    ChangeScene(selected_scene_);
-    //Begin():
-    const float fixed_time_step = timer_->FixedDeltaTime();
-    float accumulator = 0.0f;
+    const StepInputs inputs{imgui_interface_->speed_multiplier(), imgui_interface_->planets_colour(), imgui_interface_->show_quadtree()};
+    if (inputs == posted_inputs_) { return; }
+    posted_inputs_ = inputs;
+    Post([this, inputs] { step_inputs_ = inputs; });
+}
 
-    while (is_running_)
+void GameEngine::UpdatePanelState()
+{
+    panel_state_.stats = scene_stats();
+    panel_state_.stats_history = stats_history_;
+    panel_state_.step_hash = scene_step_hash();
+    panel_state_.scene_seed = scene_seed_;
+    panel_state_.step_budget = step_budget_;
+    const physics::SolverSettings* settings = scene_solver_settings();
+    panel_state_.has_solver_settings = settings != nullptr;
+    if (settings)
     {
-        // Handle events
-        HandleEvents();
-        imgui_interface_->Update(is_running_);
+        panel_state_.solver_settings = *settings;
+    }
+}
 
-        // Update the timer
-        timer_->Tick();
-        float delta_time = timer_->DeltaTime();
-        accumulator += delta_time;
+const physics::SolverSettings* GameEngine::solver_settings() const
+{
+    return panel_state_.has_solver_settings ? &panel_state_.solver_settings : nullptr;
+}
 
+physics::SolverSettings* GameEngine::scene_solver_settings() const
+{
+    switch (selected_scene_)
+    {
+    case SystemScene::CollisionSystemScene:
+        return &collision_system_->solver_settings();
+    case SystemScene::FrictionSystemScene:
+        return &friction_system_->solver_settings();
+    default:
+        return nullptr;
+    }
+}
+
+std::uint64_t GameEngine::scene_step_hash() const
+{
+    switch (selected_scene_)
+    {
+    case SystemScene::CollisionSystemScene:
+        return collision_system_->step_hash();
+    case SystemScene::FrictionSystemScene:
+        return friction_system_->step_hash();
+    default:
+        return 0;
+    }
+}
+
+const physics::Stats& GameEngine::scene_stats() const
+{
+    switch (selected_scene_)
+    {
+    case SystemScene::TriggerSystemScene:
+        return trigger_system_->stats();
+    case SystemScene::CollisionSystemScene:
+        return collision_system_->stats();
+    case SystemScene::FrictionSystemScene:
+        return friction_system_->stats();
+    default:
+        return planet_system_->stats();
+    }
+}
+
+void GameEngine::StepScene(const float fixed_time_step)
+{
+    // Update all systems with the fixed time step
+    if (selected_scene_ == SystemScene::PlanetSystemScene)
+    {
+        planet_system_->Update(fixed_time_step * step_inputs_.speed_multiplier * 1000.0f, step_inputs_.planets_colour);
+    }
+    else if (selected_scene_ == SystemScene::TriggerSystemScene)
+    {
+        trigger_system_->Update(fixed_time_step * step_inputs_.speed_multiplier);
+    }
+    else if (selected_scene_ == SystemScene::CollisionSystemScene)
+    {
+        collision_system_->Update(fixed_time_step * step_inputs_.speed_multiplier);
+    }
+    else if (selected_scene_ == SystemScene::FrictionSystemScene)
+    {
+        friction_system_->Update(fixed_time_step * step_inputs_.speed_multiplier * 4.f);
+    }
+    stats_history_.Record(scene_stats());
 
-// Fixed Time Step Update
-        while (accumulator >= fixed_time_step)
+    if (physics::SolverSettings* settings = scene_solver_settings())
+    {
+        step_budget_.UpdateSolver(*settings, scene_stats().last_step.StepMicroseconds() * 1e-6f, fixed_time_step);
+    }
+}
+
+void GameEngine::DispatchSceneEvents()
+{
+    //Contact and trigger callbacks run once the physics steps of the frame are done
+    if (selected_scene_ == SystemScene::TriggerSystemScene)
+    {
+        trigger_system_->DispatchTriggerEvents();
+    }
+    else if (selected_scene_ == SystemScene::CollisionSystemScene)
+    {
+        collision_system_->DispatchContactEvents();
+    }
+    else if (selected_scene_ == SystemScene::FrictionSystemScene)
+    {
+        friction_system_->DispatchContactEvents();
+    }
+}
+
+namespace
+{
+    //Geometry of an object drawn between the start of its last step (alpha 0) and its current state (alpha 1)
+    //Only the circles of rotating bodies show their orientation
+    void AddObjectGeometry(GraphicsManager& graphics_manager, const GameObject& object, const float alpha)
+    {
+        const auto& body = object.body();
+        const auto& collider = object.collider();
+        const bool rotation = !body.has_fixed_rotation();
+        const math::Vec2f offset = body.InterpolatedPosition(alpha) - body.position();
+        switch (collider.GetShapeType())
         {
-            // Update all systems with the fixed time step
-            if (selected_scene_ == SystemScene::PlanetSystemScene)
-            {
-                planet_system_->Update(fixed_time_step * imgui_interface_->speed_multiplier() * 1000.0f, imgui_interface_->planets_colour());
-            }
-            else if (selected_scene_ == SystemScene::TriggerSystemScene)
-            {
-                trigger_system_->Update(fixed_time_step * imgui_interface_->speed_multiplier());
-            }
-            else if (selected_scene_ == SystemScene::CollisionSystemScene)
+        case math::ShapeType::kAABB:
+            graphics_manager.CreateAABB(collider.GetBoundingBox().min_bound() + offset,
+                                        collider.GetBoundingBox().max_bound() + offset, object.color(), true);
+            break;
+        case math::ShapeType::kCircle:
+            graphics_manager.CreateCircle(object.position() + offset, object.radius(), object.color(), rotation,
+                                          rotation ? body.InterpolatedOrientation(alpha) : 0.0f);
+            break;
+        case math::ShapeType::kPolygon:
+            graphics_manager.CreatePolygon(collider.polygon().vertices(), object.position() + offset, object.color(), true, offset);
+            break;
+        default:
+            break;
+        }
+    }
+
+    void AddObjectShape(RenderSnapshot& snapshot, const GameObject& object)
+    {
+        const auto& body = object.body();
+        const auto& collider = object.collider();
+        const bool rotation = !body.has_fixed_rotation();
+        RenderShape shape{collider.GetShapeType(), object.position()};
+        shape.step_start_offset = body.InterpolatedPosition(0.0f) - body.position();
+        shape.color = object.color();
+        switch (shape.type)
+        {
+        case math::ShapeType::kAABB:
+            shape.position = collider.GetBoundingBox().min_bound();
+            shape.max_bound = collider.GetBoundingBox().max_bound();
+            break;
+        case math::ShapeType::kCircle:
+            shape.radius = object.radius();
+            shape.rotation = rotation;
+            if (rotation)
             {
-                collision_system_->Update(fixed_time_step * imgui_interface_->speed_multiplier());
+                shape.orientation = body.orientation();
+                shape.step_start_orientation = body.InterpolatedOrientation(0.0f);
             }
-            else if (selected_scene_ == SystemScene::FrictionSystemScene)
+            break;
+        case math::ShapeType::kPolygon:
             {
-                friction_system_->Update(fixed_time_step * imgui_interface_->speed_multiplier() * 4.f);
+                const auto vertices = collider.polygon().vertices();
+                shape.first_vertex = static_cast<std::uint32_t>(snapshot.polygon_vertices.size());
+                shape.vertex_count = static_cast<std::uint32_t>(vertices.size());
+                snapshot.polygon_vertices.insert(snapshot.polygon_vertices.end(), vertices.begin(), vertices.end());
+                break;
             }
+        default:
+            return;
+        }
+        snapshot.shapes.push_back(shape);
+    }
+}
 
-            accumulator -= fixed_time_step; // Decrease the accumulator
+void GameEngine::BuildRenderGeometry(const float alpha)
+{
+    // Render all systems based on the current state
+    if (selected_scene_ == SystemScene::PlanetSystemScene)
+    {
+        graphics_manager_->CreateCircle(planet_system_->star()->position(), 10.f, SDL_Color(255,255,255,150) , false);
+        circle_centres_.clear();
+        circle_radii_.clear();
+        circle_colors_.clear();
+        for (const auto& p : planet_system_->planets())
+        {
+            circle_centres_.push_back(p.body().InterpolatedPosition(alpha));
+            circle_radii_.push_back(p.radius());
+            circle_colors_.push_back(p.color());
+        }
+        graphics_manager_->CreateCircles(circle_centres_, circle_radii_, circle_colors_);
+    }
+    else if (selected_scene_ == SystemScene::TriggerSystemScene)
+    {
+        for (const auto& g : trigger_system_->objects())
+        {
+            AddObjectGeometry(*graphics_manager_, g, alpha);
+        }
+        if(imgui_interface_->show_quadtree()){trigger_system_->quadtree()->Draw(display_->renderer());}
+    }
+    else if (selected_scene_ == SystemScene::CollisionSystemScene)
+    {
+        for (const auto& g : collision_system_->objects())
+        {
+            AddObjectGeometry(*graphics_manager_, g, alpha);
         }
+        if(imgui_interface_->show_quadtree()){collision_system_->quadtree()->Draw(display_->renderer());}
+    }
+    else if (selected_scene_ == SystemScene::FrictionSystemScene)
+    {
+        for (const auto& g : friction_system_->objects())
+        {
+            AddObjectGeometry(*graphics_manager_, g, alpha);
+        }
+        if(imgui_interface_->show_quadtree()){friction_system_->quadtree()->Draw(display_->renderer());}
+    }
+}
 
-        // Render
-        display_->Clear();
-        graphics_manager_->Clear();
+void GameEngine::WriteSnapshot(RenderSnapshot& snapshot)
+{
+    PROFILE_ZONE();
+    snapshot.Clear();
+    const physics::Quadtree* quadtree = nullptr;
+
+    if (selected_scene_ == SystemScene::PlanetSystemScene)
+    {
+        RenderShape star{math::ShapeType::kCircle, planet_system_->star()->position()};
+        star.radius = 10.f;
+        star.color = SDL_Color(255,255,255,150);
+        snapshot.shapes.push_back(star);
+        for (const auto& p : planet_system_->planets())
+        {
+            RenderShape planet{math::ShapeType::kCircle, p.position()};
+            planet.step_start_offset = p.body().InterpolatedPosition(0.0f) - p.position();
+            planet.radius = p.radius();
+            planet.color = p.color();
+            snapshot.shapes.push_back(planet);
+        }
+    }
+    else if (selected_scene_ == SystemScene::TriggerSystemScene)
+    {
+        for (const auto& g : trigger_system_->objects())
+        {
+            AddObjectShape(snapshot, g);
+        }
+        quadtree = trigger_system_->quadtree();
+    }
+    else if (selected_scene_ == SystemScene::CollisionSystemScene)
+    {
+        for (const auto& g : collision_system_->objects())
+        {
+            AddObjectShape(snapshot, g);
+        }
+        quadtree = collision_system_->quadtree();
+    }
+    else if (selected_scene_ == SystemScene::FrictionSystemScene)
+    {
+        for (const auto& g : friction_system_->objects())
+        {
+            AddObjectShape(snapshot, g);
+        }
+        quadtree = friction_system_->quadtree();
+    }
+
+    if (quadtree && step_inputs_.show_quadtree)
+    {
+        quadtree->CollectBounds(snapshot.quadtree_nodes);
+    }
+    snapshot.step_end = std::chrono::steady_clock::now();
+}
 
-        // Render all systems based on the current state
-        if (selected_scene_ == SystemScene::PlanetSystemScene)
+void GameEngine::DrawSnapshot(const RenderSnapshot& snapshot, const float alpha)
+{
+    for (const auto& shape : snapshot.shapes)
+    {
+        const math::Vec2f offset = shape.step_start_offset * (1.0f - alpha);
+        switch (shape.type)
         {
-            graphics_manager_->CreateCircle(planet_system_->star()->position(), 10.f, SDL_Color(255,255,255,150) , false);
-            for (auto p : planet_system_->planets())
+        case math::ShapeType::kAABB:
+            graphics_manager_->CreateAABB(shape.position + offset, shape.max_bound + offset, shape.color, true);
+            break;
+        case math::ShapeType::kCircle:
+            graphics_manager_->CreateCircle(shape.position + offset, shape.radius, shape.color, shape.rotation,
+                                            shape.step_start_orientation + (shape.orientation - shape.step_start_orientation) * alpha);
+            break;
+        case math::ShapeType::kPolygon:
+            graphics_manager_->CreatePolygon(std::span(snapshot.polygon_vertices).subspan(shape.first_vertex, shape.vertex_count),
+                                             shape.position + offset, shape.color, true, offset);
+            break;
+        default:
+            break;
+        }
+    }
+
+    SDL_SetRenderDrawColor(display_->renderer(), 255, 255, 255, 255);
+    for (const auto& bounds : snapshot.quadtree_nodes)
+    {
+        const SDL_Rect rect{static_cast<int>(bounds.min_bound().x), static_cast<int>(bounds.min_bound().y),
+                            static_cast<int>(bounds.max_bound().x - bounds.min_bound().x),
+                            static_cast<int>(bounds.max_bound().y - bounds.min_bound().y)};
+        SDL_RenderDrawRect(display_->renderer(), &rect);
+    }
+}
+
+void GameEngine::PhysicsLoop(const std::stop_token stop_token, const float fixed_time_step)
+{
+    using Clock = std::chrono::steady_clock;
+    const auto step_duration = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<float>(fixed_time_step));
+    auto next_step = Clock::now();
+    Clock::duration late_time{};
+
+    while (!stop_token.stop_requested())
+    {
+        {
+            PROFILE_ZONE_NAMED("Physics Step");
+            std::lock_guard lock(scene_mutex_);
+            RunCommands();
+            step_budget_.Drop(std::chrono::duration<double>(late_time).count(), fixed_time_step);
+            StepScene(fixed_time_step);
+            DispatchSceneEvents();
+            WriteSnapshot(snapshots_.write_buffer());
+        }
+        snapshots_.Publish();
+
+        //A late step is not made up with a burst of steps, the simulation slows down and the lost time is reported
+        next_step += step_duration;
+        late_time = Clock::duration::zero();
+        if (const auto now = Clock::now(); next_step < now)
+        {
+            late_time = now - next_step;
+            next_step = now;
+        }
+        std::this_thread::sleep_until(next_step);
+    }
+}
+
+void GameEngine::StartPhysicsThread(const float fixed_time_step)
+{
+    physics_thread_ = std::jthread([this, fixed_time_step](const std::stop_token stop_token)
+    {
+        //The engine of a new thread is seeded from the system, a deterministic scene draws from its seed instead
+        SeedScene();
+        PhysicsLoop(stop_token, fixed_time_step);
+    });
+}
+
+void GameEngine::StopPhysicsThread()
+{
+    if (physics_thread_.joinable())
+    {
+        physics_thread_.request_stop();
+        physics_thread_.join();
+        //The changes posted after the last step apply before the frames step the scenes again
+        RunCommands();
+    }
+}
+
+void GameEngine::Run()
+{
+    ChangeScene(selected_scene_);
+    //Begin():
+    const float fixed_time_step = timer_->FixedDeltaTime();
+    float accumulator = 0.0f;
+
+    while (is_running_)
+    {
+        // Handle events, with the physics thread the input and the panel changes are posted for its next step
+        {
+            PROFILE_ZONE_NAMED("Events");
+            if (physics_thread_.joinable())
             {
-                graphics_manager_->CreateCircle(p.position(), p.radius(), p.color(), false);
+                std::lock_guard lock(scene_mutex_);
+                UpdatePanelState();
             }
+            else
+            {
+                UpdatePanelState();
+            }
+            HandleEvents();
+            imgui_interface_->Update(is_running_);
+            PostStepInputs();
         }
-        else if (selected_scene_ == SystemScene::TriggerSystemScene)
+
+        if (imgui_interface_->physics_thread() != physics_thread_.joinable())
         {
-            for (auto g : trigger_system_->objects())
+            if (imgui_interface_->physics_thread())
             {
-                switch (g.collider().GetShapeType())
-                {
-                case math::ShapeType::kAABB:
-                    graphics_manager_->CreateAABB(g.collider().GetBoundingBox().min_bound(),
-                                                  g.collider().GetBoundingBox().max_bound(), g.color(), true);
-                    break;
-                case math::ShapeType::kCircle:
-                    graphics_manager_->CreateCircle(g.position(), g.radius(), g.color(), false);
-                    break;
-                default:
-                    break;
-                }
+                StartPhysicsThread(fixed_time_step);
             }
-            if(imgui_interface_->show_quadtree()){trigger_system_->quadtree()->Draw(display_->renderer());}
+            else
+            {
+                StopPhysicsThread();
+            }
+            accumulator = 0.0f;
         }
-        else if (selected_scene_ == SystemScene::CollisionSystemScene)
+
+        // Update the timer
+        timer_->Tick();
+        if (!physics_thread_.joinable())
         {
-            for (auto g : collision_system_->objects())
+            PROFILE_ZONE_NAMED("Fixed Steps");
+            float delta_time = timer_->DeltaTime();
+            accumulator += delta_time;
+
+
+            // Fixed Time Step Update, capped so slow steps do not pile up more steps in the next frames
+            const int step_count = step_budget_.TakeSteps(accumulator, fixed_time_step);
+            for (int i = 0; i < step_count; ++i)
             {
-                switch (g.collider().GetShapeType())
-                {
-                case math::ShapeType::kAABB:
-                    graphics_manager_->CreateAABB(g.collider().GetBoundingBox().min_bound(),
-                                                  g.collider().GetBoundingBox().max_bound(), g.color(), true);
-                    break;
-                case math::ShapeType::kCircle:
-                    graphics_manager_->CreateCircle(g.position(), g.radius(), g.color(), false);
-                    break;
-                default:
-                    break;
-                }
+                StepScene(fixed_time_step);
             }
-            if(imgui_interface_->show_quadtree()){collision_system_->quadtree()->Draw(display_->renderer());}
+
+            DispatchSceneEvents();
         }
-        else if (selected_scene_ == SystemScene::FrictionSystemScene)
+
+        // Render
         {
-            for (auto g : friction_system_->objects())
+            PROFILE_ZONE_NAMED("Render Build");
+            display_->Clear();
+            graphics_manager_->Clear();
+
+            //The frame shows the bodies alpha of the way through the last step, from its start to its end
+            //With the physics thread the frame draws the latest snapshot, or the previous one again if no step ended since
+            if (physics_thread_.joinable())
             {
-                switch (g.collider().GetShapeType())
-                {
-                case math::ShapeType::kAABB:
-                    graphics_manager_->CreateAABB(g.collider().GetBoundingBox().min_bound(),
-                                                  g.collider().GetBoundingBox().max_bound(), g.color(), true);
-                    break;
-                case math::ShapeType::kCircle:
-                    graphics_manager_->CreateCircle(g.position(), g.radius(), g.color(), false);
-                    break;
-                default:
-                    break;
-                }
+                snapshots_.Acquire();
+                const RenderSnapshot& snapshot = snapshots_.read_buffer();
+                const float since_step = std::chrono::duration<float>(std::chrono::steady_clock::now() - snapshot.step_end).count();
+                const float alpha = imgui_interface_->interpolate() ? std::clamp(since_step / fixed_time_step, 0.0f, 1.0f) : 1.0f;
+                DrawSnapshot(snapshot, alpha);
+            }
+            else
+            {
+                const float alpha = imgui_interface_->interpolate() ? accumulator / fixed_time_step : 1.0f;
+                BuildRenderGeometry(alpha);
             }
-            if(imgui_interface_->show_quadtree()){friction_system_->quadtree()->Draw(display_->renderer());}
         }
 
         // Render the graphics
-        SDL_RenderGeometry(display_->renderer(),
-                           nullptr,
-                           graphics_manager_->vertices().data(),
-                           static_cast<int>(graphics_manager_->vertices().size()),
-                           graphics_manager_->indices().data(),
-                           static_cast<int>(graphics_manager_->indices().size()));
+        {
+            PROFILE_ZONE_NAMED("Present");
+            SDL_RenderGeometry(display_->renderer(),
+                               nullptr,
+                               graphics_manager_->vertices().data(),
+                               static_cast<int>(graphics_manager_->vertices().size()),
+                               graphics_manager_->indices().data(),
+                               static_cast<int>(graphics_manager_->indices().size()));
+
+            imgui_interface_->Render();
+            SDL_RenderPresent(display_->renderer());
+        }
 
-        imgui_interface_->Render();
-        SDL_RenderPresent(display_->renderer());
+        PROFILE_PLOT_ALLOCATIONS();
+        PROFILE_FRAME();
     }
+    StopPhysicsThread();
     // End()
 }
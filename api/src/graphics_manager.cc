@@ -1,6 +1,16 @@
 ﻿#include "graphics_manager.h"
 
+#if defined(__SSE__) || defined(_M_X64)
+#include <xmmintrin.h>
+#endif
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+
 #include "common.h"
+#include "profiler.h"
 
 void GraphicsManager::AddVertex(const math::Vec2f position, const SDL_Color color)
 {
@@ -17,59 +27,126 @@ void GraphicsManager::Clear()
     indices_.clear();
 }
 
-void GraphicsManager::CreateCircle(const math::Vec2f centre, const float radius, const SDL_Color color, const bool rotation)
+namespace
 {
-    //Track where the new circle's vertices start
-    const size_t starting_index = vertices_.size();
-
-    constexpr float angle_step = (2 * common::Pi) / kCircleVertexCount;
-
-    //Add the centre of the circle
-    AddVertex(centre, SDL_Color{0, 0, 0, 0});
+    //Outline of the unit circle, x and y interleaved so one SSE register holds two points
+    alignas(16) constexpr std::array<float, 2 * kCircleVertexCount> kUnitCircle = []
+    {
+        std::array<float, 2 * kCircleVertexCount> points{};
+        for (size_t i = 0; i < kCircleVertexCount; ++i)
+        {
+            const float angle = static_cast<float>(i) * (2 * common::Pi) / kCircleVertexCount;
+            points[2 * i] = common::Cos(angle);
+            points[2 * i + 1] = common::Sin(angle);
+        }
+        return points;
+    }();
+    static_assert(kCircleVertexCount % 2 == 0, "The circle outline is written two points at a time");
 
+    //Triangle fan around the centre vertex, offset by the first vertex of each circle
+    constexpr std::array<int, kCircleIndexCount> kCircleIndices = []
     {
-    const float angle = static_cast<float>(0) * angle_step;
-    const float x = centre.x + radius * std::cos(angle);
-    const float y = centre.y + radius * std::sin(angle);
-    if(rotation)
+        std::array<int, kCircleIndexCount> indices{};
+        for (size_t i = 0; i < kCircleVertexCount; ++i)
+        {
+            indices[3 * i] = 0;
+            indices[3 * i + 1] = static_cast<int>(i + 1);
+            indices[3 * i + 2] = static_cast<int>(i + 2 > kCircleVertexCount ? 1 : i + 2);
+        }
+        return indices;
+    }();
+
+    void WriteCircleIndices(int* indices, const int first_vertex)
     {
-        AddVertex(math::Vec2f{x, y}, SDL_Color{0, 0, 0, 255});
-    }
-        else
+        for (size_t i = 0; i < kCircleIndexCount; ++i)
         {
-            AddVertex(math::Vec2f{x, y}, SDL_Color{color.r, color.g, color.b, color.a});
+            indices[i] = first_vertex + kCircleIndices[i];
         }
     }
+}
+
+void GraphicsManager::CreateCircle(const math::Vec2f centre, const float radius, const SDL_Color color, const bool rotation, const float orientation)
+{
+    PROFILE_ZONE();
+    //Track where the new circle's vertices start
+    const size_t starting_index = vertices_.size();
 
+    //Add the centre of the circle
+    AddVertex(centre, SDL_Color{0, 0, 0, 0});
 
-    //Generate vertices
-    for (size_t i = 1; i < kCircleVertexCount; i++)
+    //The table is turned by the orientation, two trigonometric calls per rotated circle instead of two per vertex
+    const math::Vec2f axis = orientation == 0.0f ? math::Vec2f(1.0f, 0.0f) : math::Vec2f(std::cos(orientation), std::sin(orientation));
+    for (size_t i = 0; i < kCircleVertexCount; i++)
     {
-        const float angle = static_cast<float>(i) * angle_step;
-        const float x = centre.x + radius * std::cos(angle);
-        const float y = centre.y + radius * std::sin(angle);
+        const float unit_x = kUnitCircle[2 * i];
+        const float unit_y = kUnitCircle[2 * i + 1];
+        const math::Vec2f point(centre.x + radius * (unit_x * axis.x - unit_y * axis.y),
+                                centre.y + radius * (unit_x * axis.y + unit_y * axis.x));
 
-        AddVertex(math::Vec2f{x, y}, color);
+        //The first outer vertex marks the orientation of the circle
+        AddVertex(point, i == 0 && rotation ? SDL_Color{0, 0, 0, 255} : color);
     }
 
-    //Generate indices
-    for (size_t i = 0; i < kCircleVertexCount - 1; i++)
+    const size_t first_index = indices_.size();
+    indices_.resize(first_index + kCircleIndexCount);
+    WriteCircleIndices(indices_.data() + first_index, static_cast<int>(starting_index));
+}
+
+void GraphicsManager::CreateCircles(const std::span<const math::Vec2f> centres, const std::span<const float> radii,
+                                    const std::span<const SDL_Color> colors)
+{
+    PROFILE_ZONE();
+    constexpr size_t kVerticesPerCircle = kCircleVertexCount + 1;
+    assert(centres.size() == radii.size() && centres.size() == colors.size() && "CreateCircles needs one radius and one colour per centre");
+    const size_t count = std::min({centres.size(), radii.size(), colors.size()});
+
+    //The buffers only grow, Clear keeps their capacity, so after the first frames nothing is allocated here
+    const size_t first_vertex = vertices_.size();
+    const size_t first_index = indices_.size();
+    vertices_.resize(first_vertex + count * kVerticesPerCircle);
+    indices_.resize(first_index + count * kCircleIndexCount);
+
+    for (size_t c = 0; c < count; ++c)
     {
-        indices_.push_back(static_cast<int>(starting_index));          //Center vertex
-        indices_.push_back(static_cast<int>(starting_index + i + 1));  //Current outer vertex
-        indices_.push_back(static_cast<int>(starting_index + i + 2));  //Next outer vertex
-    }
+        SDL_Vertex* vertex = vertices_.data() + first_vertex + c * kVerticesPerCircle;
+        const math::Vec2f centre = centres[c];
+        const SDL_Color color = colors[c];
 
+        vertex[0] = SDL_Vertex{SDL_FPoint{centre.x, centre.y}, SDL_Color{0, 0, 0, 0}, SDL_FPoint{0.0f, 0.0f}};
 
-    //Last triangle, closing the circle
-    indices_.push_back(static_cast<int>(starting_index));
-    indices_.push_back(static_cast<int>(starting_index + kCircleVertexCount));
-    indices_.push_back(static_cast<int>(starting_index + 1));
+#if defined(__SSE__) || defined(_M_X64)
+        //Two outline points per register, stored as the 64 bit positions of two consecutive vertices
+        const __m128 centre_xy = _mm_setr_ps(centre.x, centre.y, centre.x, centre.y);
+        const __m128 radius = _mm_set1_ps(radii[c]);
+        for (size_t i = 0; i < kCircleVertexCount; i += 2)
+        {
+            const __m128 points = _mm_add_ps(centre_xy, _mm_mul_ps(radius, _mm_load_ps(&kUnitCircle[2 * i])));
+            SDL_Vertex& vertex_a = vertex[i + 1];
+            SDL_Vertex& vertex_b = vertex[i + 2];
+            _mm_storel_pi(reinterpret_cast<__m64*>(&vertex_a.position), points);
+            _mm_storeh_pi(reinterpret_cast<__m64*>(&vertex_b.position), points);
+            vertex_a.color = color;
+            vertex_b.color = color;
+            vertex_a.tex_coord = SDL_FPoint{0.0f, 0.0f};
+            vertex_b.tex_coord = SDL_FPoint{0.0f, 0.0f};
+        }
+#else
+        const float radius = radii[c];
+        for (size_t i = 0; i < kCircleVertexCount; ++i)
+        {
+            const SDL_FPoint point{centre.x + radius * kUnitCircle[2 * i], centre.y + radius * kUnitCircle[2 * i + 1]};
+            vertex[i + 1] = SDL_Vertex{point, color, SDL_FPoint{0.0f, 0.0f}};
+        }
+#endif
 
+        WriteCircleIndices(indices_.data() + first_index + c * kCircleIndexCount,
+                           static_cast<int>(first_vertex + c * kVerticesPerCircle));
+    }
 }
 
 void GraphicsManager::CreateAABB(const math::Vec2f min, const math::Vec2f max, const SDL_Color color, bool fill_status)
 {
+    PROFILE_ZONE();
     const size_t starting_index = vertices_.size();
     AddVertex(min, color);
     AddVertex(math::Vec2f{min.x, max.y}, color);
@@ -85,8 +162,10 @@ void GraphicsManager::CreateAABB(const math::Vec2f min, const math::Vec2f max, c
     indices_.push_back(static_cast<int>(starting_index + 3));
 }
 
-void GraphicsManager::CreatePolygon(const std::vector<math::Vec2f>& points, const math::Vec2f center, const SDL_Color color, bool fill_status)
+void GraphicsManager::CreatePolygon(const std::span<const math::Vec2f> points, const math::Vec2f center, const SDL_Color color, bool fill_status,
+                                    const math::Vec2f offset)
 {
+    PROFILE_ZONE();
     const size_t starting_index = vertices_.size();
 
     AddVertex(center, color);
@@ -94,7 +173,7 @@ void GraphicsManager::CreatePolygon(const std::vector<math::Vec2f>& points, cons
     //Generate vertices
     for (const auto& point : points)
     {
-        AddVertex(math::Vec2f{point.x, point.y}, color);
+        AddVertex(math::Vec2f{point.x + offset.x, point.y + offset.y}, color);
     }
 
     //Generate indices
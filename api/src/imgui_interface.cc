@@ -2,6 +2,9 @@
 
 #include <imgui_impl_sdlrenderer2.h>
 
+#include <cfloat>
+#include <cstdint>
+
 #include "game_engine.h"
 
 void ImGuiInterface::Initialize(Display* display, GameEngine* engine)
@@ -19,6 +22,92 @@ void ImGuiInterface::Initialize(Display* display, GameEngine* engine)
     ImGui_ImplSDLRenderer2_Init(display->renderer());
 }
 
+void ImGuiInterface::SolverSettingsSliders() const
+{
+    if (game_engine_->solver_settings() == nullptr) { return; }
+
+    //The sliders edit a copy, the engine applies it before the next step
+    physics::SolverSettings settings = *game_engine_->solver_settings();
+    bool changed = ImGui::SliderInt("Substeps", &settings.substep_count, 1, physics::kMaxSubstepCount);
+    changed |= ImGui::SliderInt("Velocity Iterations", &settings.velocity_iterations, 1, physics::kMaxSolverIterations);
+    changed |= ImGui::SliderInt("Position Iterations", &settings.position_iterations, 1, physics::kMaxSolverIterations);
+    changed |= ImGui::SliderFloat("Linear Slop", &settings.linear_slop, 0.0f, 2.0f);
+
+    //Takes effect from the next reset, which reseeds the scene
+    changed |= ImGui::Checkbox("Deterministic", &settings.deterministic);
+    if (changed)
+    {
+        game_engine_->set_solver_settings(settings);
+    }
+    if (settings.deterministic)
+    {
+        std::uint64_t seed = game_engine_->scene_seed();
+        if (ImGui::InputScalar("Seed", ImGuiDataType_U64, &seed))
+        {
+            game_engine_->set_scene_seed(seed);
+        }
+        ImGui::Text("Step Hash: %016llx", static_cast<unsigned long long>(game_engine_->step_hash()));
+    }
+}
+
+void ImGuiInterface::PerformanceOverlay() const
+{
+    const physics::Stats& stats = game_engine_->stats();
+    const physics::StatsHistory& stats_history = game_engine_->stats_history();
+
+    if (!ImGui::CollapsingHeader("Performance", ImGuiTreeNodeFlags_DefaultOpen)) { return; }
+
+    const physics::StepCounters& step = stats.last_step;
+    const auto step_history = stats_history.step_microseconds();
+    const int offset = static_cast<int>(stats_history.offset());
+    const ImVec2 graph_size(0.0f, 50.0f);
+
+    ImGui::Text("Step: %.1f us", step.StepMicroseconds());
+    ImGui::PlotLines("##step", step_history.data(), static_cast<int>(step_history.size()), offset,
+                     nullptr, 0.0f, FLT_MAX, graph_size);
+
+    if (ImGui::TreeNode("Phases"))
+    {
+        for (std::size_t i = 0; i < physics::kPhaseCount; ++i)
+        {
+            const auto phase_history = stats_history.phase_microseconds(static_cast<physics::Phase>(i));
+            ImGui::PushID(static_cast<int>(i));
+            ImGui::Text("%.*s: %.1f us", static_cast<int>(physics::kPhaseNames[i].size()), physics::kPhaseNames[i].data(),
+                        step.phase_microseconds[i]);
+            ImGui::PlotLines("##phase", phase_history.data(), static_cast<int>(phase_history.size()), offset,
+                             nullptr, 0.0f, FLT_MAX, graph_size);
+            ImGui::PopID();
+        }
+        ImGui::TreePop();
+    }
+
+    ImGui::Text("Candidate Pairs: %u", step.candidate_pairs);
+    ImGui::Text("Narrow Phase Hits: %u", step.narrow_phase_hits);
+    ImGui::Text("Quadtree Nodes: %u (depth %u)", step.quadtree_nodes, step.quadtree_depth);
+    ImGui::Text("Quadtree Queries: %u", step.quadtree_queries);
+    ImGui::Text("Solver Iterations: %u", step.solver_iterations);
+
+    const physics::StepBudget& budget = game_engine_->step_budget();
+    int max_steps = budget.max_steps_per_frame();
+    if (ImGui::SliderInt("Max Steps/Frame", &max_steps, 1, physics::kMaxStepsPerFrame))
+    {
+        game_engine_->set_max_steps_per_frame(max_steps);
+    }
+    ImGui::Text("Dropped: %.2f s (%llu steps)", budget.dropped_seconds(), static_cast<unsigned long long>(budget.dropped_steps()));
+
+    //Lowers the velocity iterations, then the substeps, while the steps take more than half of the fixed step
+    bool adaptive = budget.adaptive();
+    if (ImGui::Checkbox("Adaptive Solver", &adaptive))
+    {
+        game_engine_->set_adaptive(adaptive);
+    }
+    if (const physics::SolverSettings* settings = game_engine_->solver_settings(); settings && adaptive)
+    {
+        ImGui::Text("Load Reduction: %d (%d substeps, %d iterations)", settings->load_reduction,
+                    settings->SubstepCount(), settings->VelocityIterations());
+    }
+}
+
 void ImGuiInterface::Update(bool& show_imgui)
 {
     //Start new ImGui frame
@@ -41,7 +130,14 @@ void ImGuiInterface::Update(bool& show_imgui)
 
         // Display FPS at the top
         ImGui::Text("FPS: %.1f", ImGui::GetIO().Framerate);
-
+        //Steps the scene on its own thread at the fixed rate, the frames draw its latest snapshot
+        ImGui::Checkbox("Physics Thread", &physics_thread_);
+        //Draws the bodies between their last two fixed steps instead of at the last one
+        ImGui::Checkbox("Interpolate", &interpolate_);
+        if (game_engine_)
+        {
+            PerformanceOverlay();
+        }
 
         ImGui::Separator();
 
@@ -120,6 +216,7 @@ void ImGuiInterface::Update(bool& show_imgui)
                 ImGui::Checkbox("Show Quadtree", &show_quadtree_);
 
                 ImGui::SliderFloat("Speed Mult", &speed_multiplier_, 0.0f, 10.0f);
+                SolverSettingsSliders();
                 break;
             }
         case SystemScene::FrictionSystemScene: // Friction System
@@ -127,6 +224,7 @@ void ImGuiInterface::Update(bool& show_imgui)
                 ImGui::PushTextWrapPos();
                 ImGui::Text("Left Click: Spawn Circle");
                 ImGui::Text("Right Click: Spawn AABB");
+                ImGui::Text("Middle Click: Spawn Polygon");
                 ImGui::PopTextWrapPos();
 
                 ImGui::Separator();
@@ -134,6 +232,7 @@ void ImGuiInterface::Update(bool& show_imgui)
                 ImGui::Checkbox("Show Quadtree", &show_quadtree_);
 
                 ImGui::SliderFloat("Speed Mult", &speed_multiplier_, 0.0f, 2.0f);
+                SolverSettingsSliders();
                 break;
             }
         default:
@@ -0,0 +1,158 @@
+#include "object_pairs.h"
+
+#include "profiler.h"
+
+void FindPairsBruteForce(const std::span<GameObject> objects, std::unordered_map<GameObjectPair, bool>& pairs)
+{
+    PROFILE_ZONE();
+    pairs.clear();
+
+    // Loop through all objects
+    for (size_t i = 0; i < objects.size(); ++i)
+    {
+        auto& objectA = objects[i];
+        auto& colliderA = objectA.collider();
+
+        // Get the AABB of the first collider
+        auto rangeA = colliderA.GetBoundingBox();
+
+        // Compare with all other objects
+        for (size_t j = i + 1; j < objects.size(); ++j)
+        {
+            auto& objectB = objects[j];
+            auto& colliderB = objectB.collider();
+
+            // Get the AABB of the second collider
+            auto rangeB = colliderB.GetBoundingBox();
+
+            // Check for AABB overlap, between layers that collide and never between two static bodies
+            if (objectA.body().type() == physics::BodyType::Static && objectB.body().type() == physics::BodyType::Static)
+            {
+                continue;
+            }
+            if (colliderA.ShouldCollide(colliderB) && math::Intersect(rangeA, rangeB))
+            {
+                GameObjectPair pair{&objectA, &objectB};
+                pairs[pair] = true;
+            }
+        }
+    }
+}
+
+void FindPairs(const std::span<GameObject> objects, physics::Quadtree& quadtree,
+               const std::unordered_map<physics::Collider*, GameObject*>& collider_to_object_map,
+               std::vector<physics::Collider*>& query_results, physics::StepCounters& step,
+               std::unordered_map<GameObjectPair, bool>& pairs)
+{
+    PROFILE_ZONE();
+    pairs.clear();
+
+    {
+        PROFILE_ZONE_NAMED("Quadtree Build");
+        quadtree.Clear();
+        for (auto& object : objects)
+        {
+            quadtree.Insert(&object.collider());
+        }
+        quadtree.CountNodes(step.quadtree_nodes, step.quadtree_depth);
+    }
+
+    const auto find_object = [&collider_to_object_map](physics::Collider* collider) -> GameObject*
+    {
+        const auto it = collider_to_object_map.find(collider);
+        return it != collider_to_object_map.end() ? it->second : nullptr;
+    };
+
+    // Use AABB tests for broad phase
+    for (auto& object : objects)
+    {
+        //Static bodies do not look for pairs, the moving bodies touching them find those pairs, so two static bodies never pair up
+        if (object.body().type() == physics::BodyType::Static)
+        {
+            continue;
+        }
+
+        auto& collider = object.collider();
+        step.quadtree_queries++;
+        // The quadtree only returns the other colliders whose bounds overlap this one and whose layers match
+        quadtree.Query(collider, query_results);
+        for (auto* otherCollider : query_results)
+        {
+            GameObject* objectA = find_object(&collider);
+            GameObject* objectB = find_object(otherCollider);
+            if (objectA && objectB)
+            {
+                GameObjectPair pair{objectA, objectB};
+                pairs[pair] = true;
+            }
+        }
+    }
+}
+
+//Called on the first collision frame
+void OnPairCollideStart(const GameObjectPair& pair)
+{
+    if(!pair.gameObjectA_ || !pair.gameObjectB_){return;}
+
+    pair.gameObjectA_->AddCollision();
+    pair.gameObjectB_->AddCollision();
+
+    if (pair.gameObjectA_->collider().is_trigger() || pair.gameObjectB_->collider().is_trigger())
+    {
+        pair.gameObjectA_->OnTriggerEnter();
+        pair.gameObjectB_->OnTriggerEnter();
+    }
+    else
+    {
+        pair.gameObjectA_->OnCollisionEnter();
+        pair.gameObjectB_->OnCollisionEnter();
+    }
+}
+
+void OnPairCollideStay(const GameObjectPair& pair)
+{
+    if(!pair.gameObjectA_ || !pair.gameObjectB_){return;}
+
+    if (pair.gameObjectA_->collider().is_trigger() || pair.gameObjectB_->collider().is_trigger())
+    {
+        pair.gameObjectA_->OnTriggerStay();
+        pair.gameObjectB_->OnTriggerStay();
+    }
+    else
+    {
+        //pair.gameObjectA_->OnCollisionStay();
+        //pair.gameObjectB_->OnCollisionStay();
+    }
+}
+
+void OnPairCollideEnd(const GameObjectPair& pair)
+{
+    if (!pair.gameObjectA_ || !pair.gameObjectB_) return;
+
+    pair.gameObjectA_->SubCollision();
+    pair.gameObjectB_->SubCollision();
+
+    if (pair.gameObjectA_->collider().is_trigger() || pair.gameObjectB_->collider().is_trigger())
+    {
+        if (pair.gameObjectA_->collisions_count() <= 0)
+        {
+            pair.gameObjectA_->OnTriggerExit();
+        }
+        if (pair.gameObjectB_->collisions_count() <= 0)
+        {
+            pair.gameObjectB_->OnTriggerExit();
+        }
+    }
+    else
+    {
+
+        if (pair.gameObjectA_->collisions_count() <= 0)
+        {
+            pair.gameObjectA_->OnCollisionExit();
+        }
+        if (pair.gameObjectB_->collisions_count() <= 0)
+        {
+            pair.gameObjectB_->OnCollisionExit();
+        }
+    }
+}
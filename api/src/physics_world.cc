@@ -0,0 +1,343 @@
+#include "physics_world.h"
+
+#include <algorithm>
+#include <ranges>
+
+#include "object_pairs.h"
+#include "state_hash.h"
+#include "time_of_impact.h"
+
+PhysicsWorld::~PhysicsWorld()
+{
+    Clear();
+}
+
+void PhysicsWorld::Initialize(const math::Bounds2f& bounds)
+{
+    Clear();
+    quadtree_ = new physics::Quadtree(bounds);
+}
+
+void PhysicsWorld::Clear()
+{
+    if (quadtree_)
+    {
+        quadtree_->Clear();
+        delete quadtree_;
+        quadtree_ = nullptr;
+    }
+
+    potential_pairs_.clear();
+    pair_order_.clear();
+    ended_pairs_.clear();
+    impacts_.clear();
+    resolved_objects_.clear();
+    step_hash_ = 0;
+    active_pairs_.clear();
+    new_active_pairs_.clear();
+    contact_events_.Clear();
+    contacts_.clear();
+    sat_cache_.clear();
+    collider_to_object_map_.clear();
+    stats_.Reset();
+}
+
+void PhysicsWorld::RegisterObject(GameObject& object)
+{
+    collider_to_object_map_[&object.collider()] = &object;
+}
+
+void PhysicsWorld::UnregisterObject(GameObject& object)
+{
+    collider_to_object_map_.erase(&object.collider());
+
+    //The pairs and events of the step must not keep a pointer to the removed object
+    const auto has_object = [&object](const GameObjectPair& pair)
+    {
+        return pair.gameObjectA_ == &object || pair.gameObjectB_ == &object;
+    };
+    std::erase_if(active_pairs_, [&has_object](const auto& entry) { return has_object(entry.first); });
+    std::erase_if(new_active_pairs_, [&has_object](const auto& entry) { return has_object(entry.first); });
+    std::erase_if(potential_pairs_, [&has_object](const auto& entry) { return has_object(entry.first); });
+    std::erase_if(sat_cache_, [&has_object](const auto& entry) { return has_object(entry.first); });
+    std::erase_if(pair_order_, has_object);
+    std::erase_if(ended_pairs_, has_object);
+    std::erase_if(impacts_, [&has_object](const Impact& impact) { return has_object(impact.pair); });
+    resolved_objects_.erase(&object);
+    std::erase_if(contacts_, [&object](const physics::ContactSolver& contact)
+    {
+        return contact.objects_[0] == &object || contact.objects_[1] == &object;
+    });
+    contact_events_.Remove(&object);
+}
+
+void PhysicsWorld::PredictMotion(const std::span<GameObject> objects, const float delta_time)
+{
+    PROFILE_ZONE();
+    for (auto& object : objects)
+    {
+        auto& body = object.body();
+        auto& collider = object.collider();
+        body.SaveStepStart();
+
+        //Grow the broad phase bounds by the motion expected over the whole step, gravity included
+        const math::Vec2f velocity = body.type() == physics::BodyType::Static ? math::Vec2f::Zero() : body.velocity() + gravity_ * delta_time;
+        collider.UpdatePosition(body.position());
+        collider.set_sweep(velocity * delta_time);
+    }
+}
+
+void PhysicsWorld::SimplisticBroadPhase(const std::span<GameObject> objects)
+{
+    FindPairsBruteForce(objects, potential_pairs_);
+}
+
+void PhysicsWorld::BroadPhase(const std::span<GameObject> objects)
+{
+    FindPairs(objects, *quadtree_, collider_to_object_map_, query_results_, stats_.step, potential_pairs_);
+
+    //Pairs that left the broad phase drop their cached axis
+    std::erase_if(sat_cache_, [this](const auto& entry) { return !potential_pairs_.contains(entry.first); });
+}
+
+void PhysicsWorld::OrderPairs()
+{
+    PROFILE_ZONE();
+    pair_order_.clear();
+    for (const auto& pair : potential_pairs_ | std::views::keys)
+    {
+        pair_order_.push_back(pair);
+    }
+
+    //The objects share one contiguous storage, so their addresses give the same order in every run
+    if (solver_settings_.deterministic)
+    {
+        std::ranges::sort(pair_order_, {}, &GameObjectPair::SortKey);
+    }
+}
+
+void PhysicsWorld::ContinuousCollisionPhase(const float delta_time)
+{
+    PROFILE_ZONE();
+    impacts_.clear();
+    resolved_objects_.clear();
+
+    for (const auto& pair : pair_order_)
+    {
+        if (!pair.gameObjectA_ || !pair.gameObjectB_)
+        {
+            continue;
+        }
+
+        const auto& collider_a = pair.gameObjectA_->collider();
+        const auto& collider_b = pair.gameObjectB_->collider();
+        if (collider_a.is_trigger() || collider_b.is_trigger())
+        {
+            continue;
+        }
+
+        //Only bodies that move further than a fraction of their size over the step need a time of impact
+        const float threshold_a = ccd_motion_threshold_ * pair.gameObjectA_->radius();
+        const float threshold_b = ccd_motion_threshold_ * pair.gameObjectB_->radius();
+        if (collider_a.sweep().SquareMagnitude() <= threshold_a * threshold_a &&
+            collider_b.sweep().SquareMagnitude() <= threshold_b * threshold_b)
+        {
+            continue;
+        }
+
+        const auto& body_a = pair.gameObjectA_->body();
+        const auto& body_b = pair.gameObjectB_->body();
+        //The bodies have just been integrated, so their angular velocities are the ones that turned them
+        const float rotation_a = body_a.type() == physics::BodyType::Static ? 0.0f : body_a.angular_velocity() * delta_time;
+        const float rotation_b = body_b.type() == physics::BodyType::Static ? 0.0f : body_b.angular_velocity() * delta_time;
+        float time_of_impact = 1.0f;
+        if (physics::TimeOfImpact(collider_a, body_a.previous_position(), body_a.position(),
+                                  collider_b, body_b.previous_position(), body_b.position(), time_of_impact,
+                                  rotation_a, rotation_b))
+        {
+            impacts_.push_back({pair, time_of_impact});
+        }
+    }
+
+    // Resolve the earliest impacts first, each object is only rewound once per substep
+    std::ranges::sort(impacts_, {}, &Impact::time);
+    for (const auto& [pair, time] : impacts_)
+    {
+        if (resolved_objects_.contains(pair.gameObjectA_) || resolved_objects_.contains(pair.gameObjectB_))
+        {
+            continue;
+        }
+        resolved_objects_.insert(pair.gameObjectA_);
+        resolved_objects_.insert(pair.gameObjectB_);
+
+        physics::ContactSolver contact_solver;
+        contact_solver.SetContactObjects(pair);
+        contact_solver.ResolveContactAt(time, delta_time);
+    }
+}
+
+void PhysicsWorld::NarrowPhase()
+{
+    PROFILE_ZONE();
+    contacts_.clear();
+
+    for (const auto& pair : pair_order_)
+    {
+        if (!pair.gameObjectA_ || !pair.gameObjectB_)
+        {
+            continue;
+        }
+
+        const auto& collider_a = pair.gameObjectA_->collider();
+        const auto& collider_b = pair.gameObjectB_->collider();
+
+        //Polygon pairs try the axis that separated them, or the face they touched on, in the last step first
+        //Their deepest faces are kept for the manifold of the contact
+        math::SatCache* sat_cache = nullptr;
+        math::SatQuery sat_query;
+        bool intersect = false;
+        if (collider_a.GetShapeType() == math::ShapeType::kPolygon && collider_b.GetShapeType() == math::ShapeType::kPolygon)
+        {
+            sat_cache = &sat_cache_[pair];
+            intersect = math::Intersect(collider_a.polygon(), collider_b.polygon(), *sat_cache, sat_query);
+        }
+        else
+        {
+            intersect = physics::VisitShapes(collider_a, collider_b,
+                                             [](const auto& shape_a, const auto& shape_b)
+                                             {
+                                                 return math::Intersect(shape_a, shape_b);
+                                             });
+        }
+
+        if (intersect)
+        {
+            stats_.step.narrow_phase_hits++;
+            // Triggers only report the overlap, solid pairs get a contact to solve and are recorded once it is solved
+            if (collider_a.is_trigger() || collider_b.is_trigger())
+            {
+                new_active_pairs_.try_emplace(pair, physics::ContactEvent<GameObject*>{pair.gameObjectA_, pair.gameObjectB_});
+            }
+            else
+            {
+                auto& contact = contacts_.emplace_back();
+                contact.SetContactObjects(pair);
+                contact.PrepareContact(sat_cache, sat_cache ? &sat_query : nullptr);
+            }
+        }
+    }
+}
+
+void PhysicsWorld::SolveContacts(const float delta_time)
+{
+    PROFILE_ZONE();
+    if (delta_time <= 0.0f)
+    {
+        return;
+    }
+
+    const int iterations = solver_settings_.VelocityIterations();
+    for (int i = 0; i < iterations; ++i)
+    {
+        for (auto& contact : contacts_)
+        {
+            contact.ResolveVelocities();
+        }
+    }
+
+    //Split impulse, the overlap is removed through pseudo-velocities so the real velocities gain no energy
+    const int position_iterations = solver_settings_.PositionIterations();
+    stats_.step.solver_iterations += static_cast<std::uint32_t>(iterations + position_iterations);
+    const float inverse_delta_time = 1.0f / delta_time;
+    for (int i = 0; i < position_iterations; ++i)
+    {
+        for (auto& contact : contacts_)
+        {
+            contact.ResolvePseudoVelocities(inverse_delta_time, solver_settings_);
+        }
+    }
+
+    for (const auto& contact : contacts_)
+    {
+        contact.IntegratePseudoVelocities(delta_time);
+    }
+
+    //The pair keeps the normal of its last substep and the impulse of the whole step
+    for (const auto& contact : contacts_)
+    {
+        auto& event = new_active_pairs_[GameObjectPair{contact.objects_[0], contact.objects_[1]}];
+        event.handle_a = contact.objects_[0];
+        event.handle_b = contact.objects_[1];
+        event.normal = contact.contact_normal_;
+        event.impulse += contact.normal_impulse_;
+    }
+}
+
+void PhysicsWorld::UpdatePairEvents()
+{
+    PROFILE_ZONE();
+    //Only the events are recorded here, the game callbacks run in DispatchContactEvents
+    //Every touching pair is a potential pair of the step, going through them keeps the events in pair order
+    for (const auto& pair : pair_order_)
+    {
+        const auto it = new_active_pairs_.find(pair);
+        if (it == new_active_pairs_.end())
+        {
+            continue;
+        }
+        auto& event = it->second;
+        event.kind = active_pairs_.contains(pair) ? physics::ContactEventKind::kStay : physics::ContactEventKind::kBegin;
+        contact_events_.Push(event);
+    }
+
+    ended_pairs_.clear();
+    for (const auto& pair : active_pairs_ | std::views::keys)
+    {
+        if (!new_active_pairs_.contains(pair))
+        {
+            ended_pairs_.push_back(pair);
+        }
+    }
+    if (solver_settings_.deterministic)
+    {
+        std::ranges::sort(ended_pairs_, {}, &GameObjectPair::SortKey);
+    }
+    for (const auto& pair : ended_pairs_)
+    {
+        contact_events_.Push({pair.gameObjectA_, pair.gameObjectB_, math::Vec2f::Zero(), 0.0f, physics::ContactEventKind::kEnd});
+    }
+
+    std::swap(active_pairs_, new_active_pairs_);
+    new_active_pairs_.clear();
+}
+
+void PhysicsWorld::HashState(const std::span<const GameObject> objects)
+{
+    physics::StateHash hash;
+    for (const auto& object : objects)
+    {
+        hash.Add(object.body());
+    }
+    step_hash_ = hash.value();
+}
+
+void PhysicsWorld::DispatchContactEvents()
+{
+    PROFILE_ZONE();
+    contact_events_.Drain([](const physics::ContactEvent<GameObject*>& event)
+    {
+        const GameObjectPair pair{event.handle_a, event.handle_b};
+        switch (event.kind)
+        {
+        case physics::ContactEventKind::kBegin:
+            OnPairCollideStart(pair);
+            break;
+        case physics::ContactEventKind::kStay:
+            OnPairCollideStay(pair);
+            break;
+        case physics::ContactEventKind::kEnd:
+            OnPairCollideEnd(pair);
+            break;
+        }
+    });
+}
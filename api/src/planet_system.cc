@@ -5,6 +5,7 @@
 #include "display.h"
 #include "four_vec2.h"
 #include "metrics.h"
+#include "profiler.h"
 #include "random.h"
 
 void PlanetSystem::Initialize()
@@ -12,12 +13,13 @@ void PlanetSystem::Initialize()
     Clear();
     star_ = physics::Body(physics::BodyType::Static, math::Vec2f(kWindowWidth/2.f, kWindowHeight/2.f), math::Vec2f::Zero(), star_mass_);
 
-    for (std::size_t i = 0; i < kStartingPlanetsCount_; i++)
+    planets_.reserve(starting_planets_count_);
+    for (std::size_t i = 0; i < starting_planets_count_; i++)
     {
         constexpr float margin = 20.0f;
-        const math::Vec2f position(random::Range(margin, kWindowWidth - margin), random::Range(margin, kWindowHeight - margin));
-        const float radius = random::Range(5.f, 20.f);
-        const uint8_t alpha = random::Range(10, 255);
+        const math::Vec2f position(common::rng::Range(margin, kWindowWidth - margin), common::rng::Range(margin, kWindowHeight - margin));
+        const float radius = common::rng::Range(5.f, 20.f);
+        const uint8_t alpha = common::rng::Range(10, 255);
 
         CreatePlanet(position, radius, SDL_Color{ 255, 13, 132, alpha });
     }
@@ -27,11 +29,19 @@ void PlanetSystem::Initialize()
 
 void PlanetSystem::Update(float delta_time, SDL_Color colour)
 {
-    if(is_spawner_active_)
+    PROFILE_ZONE();
+    stats_.BeginStep();
     {
-        SpawnPlanets(colour);
+        physics::ScopedPhaseTimer timer(stats_, physics::Phase::kIntegrate);
+        if(is_spawner_active_)
+        {
+            SpawnPlanets(colour);
+        }
+        UpdatePlanetsSIMD(delta_time);
     }
-    UpdatePlanetsSIMD(delta_time);
+    stats_.EndStep();
+
+    PROFILE_PLOT("bodies", planets_.size());
 }
 
 void PlanetSystem::Clear()
@@ -44,6 +54,8 @@ void PlanetSystem::Clear()
 
     // Deactivate the spawner
     is_spawner_active_ = false;
+
+    stats_.Reset();
 }
 
 void PlanetSystem::CreatePlanet(const math::Vec2f position, const float radius, const SDL_Color color)
@@ -60,7 +72,7 @@ void PlanetSystem::CreatePlanet(const math::Vec2f position, const float radius,
         // Calculate angular velocity
         math::Vec2f angular_velocity = tangential_direction * orbital_velocity;
         physics::Body body(physics::BodyType::Dynamic,position, angular_velocity, planet_mass_);
-    //Random mass: random::Range(1.0f, 50.0f)
+    //Random mass: common::rng::Range(1.0f, 50.0f)
 
     auto planet = GameObject(body, radius, color);
     planets_.push_back(planet);
@@ -70,6 +82,7 @@ void PlanetSystem::CreatePlanet(const math::Vec2f position, const float radius,
 
 void PlanetSystem::UpdatePlanets(float delta_time)
 {
+    PROFILE_ZONE();
     for (auto& planet : planets_)
     {
         math::Vec2f u = star_.position() - planet.position();
@@ -82,12 +95,14 @@ void PlanetSystem::UpdatePlanets(float delta_time)
             planet.body().ApplyForce(force);
         }
 
+        planet.body().SaveStepStart();
         planet.body().Update(delta_time);
     }
 }
 
 void PlanetSystem::UpdatePlanetsSIMD(float delta_time)
 {
+    PROFILE_ZONE();
     const std::size_t simdSize = planets_.size() / 4 * 4;
 
     for (std::size_t i = 0; i < simdSize; i += 4)
@@ -121,6 +136,7 @@ void PlanetSystem::UpdatePlanetsSIMD(float delta_time)
         math::FourVec2f forces = normalizedU * forceMagnitudes;
         for (int j = 0; j < 4; ++j) {
             planets_[i+j].body().ApplyForce(math::Vec2f(forces.x[j], forces.y[j]));
+            planets_[i+j].body().SaveStepStart();
             planets_[i+j].body().Update(delta_time);
         }
     }
@@ -134,23 +150,25 @@ void PlanetSystem::UpdatePlanetsSIMD(float delta_time)
             const math::Vec2f force = force_magnitude * u.Normalized();
             planets_[i].body().ApplyForce(force);
         }
+        planets_[i].body().SaveStepStart();
         planets_[i].body().Update(delta_time);
     }
 }
 
 void PlanetSystem::SpawnPlanets(SDL_Color colour)
 {
+    PROFILE_ZONE();
     math::Vec2i mouse_pos;
     SDL_GetMouseState(&mouse_pos.x, &mouse_pos.y);
     const auto mouse_pos_f = math::Vec2f(static_cast<float>(mouse_pos.x), static_cast<float>(mouse_pos.y));
     if(constexpr float minimum_range = 30;
         metrics::ConvertToMeters((mouse_pos_f - star_.position()).Magnitude()) > metrics::ConvertToMeters(minimum_range))
     {
-        const math::Vec2f random_pos(random::Range(mouse_pos_f.x - minimum_range, mouse_pos_f.x + minimum_range),
-                                     random::Range(mouse_pos_f.y - minimum_range, mouse_pos_f.y + minimum_range));
+        const math::Vec2f random_pos(common::rng::Range(mouse_pos_f.x - minimum_range, mouse_pos_f.x + minimum_range),
+                                     common::rng::Range(mouse_pos_f.y - minimum_range, mouse_pos_f.y + minimum_range));
 
-        const float radius = random::Range(5.f, 20.f);
-        const uint8_t alpha = random::Range(10, 255);
+        const float radius = common::rng::Range(5.f, 20.f);
+        const uint8_t alpha = common::rng::Range(10, 255);
         colour.a = alpha;
 
         CreatePlanet(random_pos, radius, colour);
@@ -1,9 +1,13 @@
 ﻿#include "trigger_system.h"
 
+#include <algorithm>
+#include <array>
 #include <ranges>
 
-#include "contact_solver.h"
 #include "display.h"
+#include "four_intersect.h"
+#include "object_pairs.h"
+#include "profiler.h"
 #include "random.h"
 
 TriggerSystem::~TriggerSystem()
@@ -15,20 +19,24 @@ void TriggerSystem::Initialize()
 {
     Clear();
 
-    quadtree_ = new physics::Quadtree(math::AABB(math::Vec2f(0, 0), math::Vec2f(kWindowWidth, kWindowHeight)));
+    quadtree_ = new physics::Quadtree(world_bounds_);
     constexpr float margin = 20.0f;
 
-    for (size_t i = 0; i < number_of_objects_ / 2 - 1; i++)
+    objects_.assign(number_of_objects_, {});
+    const std::size_t circle_count = number_of_objects_ > 1 ? number_of_objects_ / 2 - 1 : number_of_objects_;
+    for (size_t i = 0; i < circle_count; i++)
     {
-        const math::Vec2f position(random::Range(margin, kWindowWidth - margin), random::Range(margin, kWindowHeight - margin));
-        const float radius = random::Range(5.f, 10.f);
+        const math::Vec2f position(common::rng::Range(world_bounds_.min_bound().x + margin, world_bounds_.max_bound().x - margin),
+                                   common::rng::Range(world_bounds_.min_bound().y + margin, world_bounds_.max_bound().y - margin));
+        const float radius = common::rng::Range(5.f, 10.f);
         math::Circle circle(position, radius);
         CreateObject(i, circle);
     }
-    for (size_t i = number_of_objects_ / 2 - 1; i < number_of_objects_; i++)
+    for (size_t i = circle_count; i < number_of_objects_; i++)
     {
-        const math::Vec2f position(random::Range(margin, kWindowWidth - margin), random::Range(margin, kWindowHeight - margin));
-        math::Vec2f half_size_vec = math::Vec2f(random::Range(5.f, 10.f),random::Range(5.f, 10.f));
+        const math::Vec2f position(common::rng::Range(world_bounds_.min_bound().x + margin, world_bounds_.max_bound().x - margin),
+                                   common::rng::Range(world_bounds_.min_bound().y + margin, world_bounds_.max_bound().y - margin));
+        math::Vec2f half_size_vec = math::Vec2f(common::rng::Range(5.f, 10.f),common::rng::Range(5.f, 10.f));
         const auto half_size_length = half_size_vec.Magnitude();
 
         math::AABB aabb(position, half_size_vec, half_size_length);
@@ -45,22 +53,25 @@ void TriggerSystem::Clear()
         quadtree_ = nullptr;
     }
 
-    for (size_t i = 0; i < number_of_objects_; ++i)
+    for (size_t i = 0; i < objects_.size(); ++i)
     {
         DeleteObject(i);
     }
 
-    objects_.fill({});
+    objects_.clear();
     collider_to_object_map_.clear();
     potential_pairs_.clear();
     active_pairs_.clear();
+    overlapping_pairs_.clear();
+    trigger_events_.clear();
+    stats_.Reset();
 }
 
 void TriggerSystem::CreateObject(size_t index, math::Circle& circle)
 {
-    math::Vec2f velocity(random::Range(-50.0f, 50.0f), random::Range(-50.0f, 50.0f));
-    physics::Body body(physics::BodyType::Dynamic,circle.centre(), velocity, random::Range(1.0f, 50.0f));
-    physics::Collider collider(circle, random::Range(1.0f, 1.0f), 0, true);
+    math::Vec2f velocity(common::rng::Range(-50.0f, 50.0f), common::rng::Range(-50.0f, 50.0f));
+    physics::Body body(physics::BodyType::Dynamic,circle.centre(), velocity, common::rng::Range(1.0f, 50.0f));
+    physics::Collider collider(circle, common::rng::Range(1.0f, 1.0f), 0, true);
     GameObject object(body, collider, circle.radius());
 
     objects_[index] = object;
@@ -69,9 +80,9 @@ void TriggerSystem::CreateObject(size_t index, math::Circle& circle)
 
 void TriggerSystem::CreateObject(size_t index, math::AABB& aabb)
 {
-    math::Vec2f velocity(random::Range(-50.0f, 50.0f), random::Range(-50.0f, 50.0f));
-    physics::Body body(physics::BodyType::Dynamic, aabb.GetCentre(), velocity, random::Range(1.0f, 50.0f));
-    physics::Collider collider(aabb, random::Range(1.0f, 1.0f), 0, true);
+    math::Vec2f velocity(common::rng::Range(-50.0f, 50.0f), common::rng::Range(-50.0f, 50.0f));
+    physics::Body body(physics::BodyType::Dynamic, aabb.GetCentre(), velocity, common::rng::Range(1.0f, 50.0f));
+    physics::Collider collider(aabb, common::rng::Range(1.0f, 1.0f), 0, true);
     GameObject object(body, collider, aabb.half_size_length());
 
     objects_[index] = object;
@@ -95,47 +106,79 @@ void TriggerSystem::RegisterObject(GameObject& object)
 void TriggerSystem::UnregisterObject(GameObject& object)
 {
     collider_to_object_map_.erase(&object.collider());
+
+    //The pairs and events of the step must not keep a pointer to the removed object
+    const auto has_object = [&object](const GameObjectPair& pair)
+    {
+        return pair.gameObjectA_ == &object || pair.gameObjectB_ == &object;
+    };
+    std::erase_if(potential_pairs_, [&has_object](const auto& entry) { return has_object(entry.first); });
+    std::erase_if(active_pairs_, has_object);
+    std::erase_if(overlapping_pairs_, has_object);
+    std::erase_if(circle_pairs_, has_object);
+    std::erase_if(aabb_pairs_, has_object);
+    std::erase_if(aabb_circle_pairs_, has_object);
+    std::erase_if(trigger_events_, [&has_object](const TriggerEvent& event) { return has_object(event.pair); });
 }
 
 void TriggerSystem::Update(const float delta_time)
 {
-    UpdateShapes(delta_time);
-    BroadPhase();
-    NarrowPhase();
+    PROFILE_ZONE();
+    stats_.BeginStep();
+    {
+        physics::ScopedPhaseTimer timer(stats_, physics::Phase::kIntegrate);
+        UpdateShapes(delta_time);
+    }
+    {
+        physics::ScopedPhaseTimer timer(stats_, physics::Phase::kBroadPhase);
+        BroadPhase();
+    }
+    stats_.step.candidate_pairs = static_cast<std::uint32_t>(potential_pairs_.size());
+    {
+        physics::ScopedPhaseTimer timer(stats_, physics::Phase::kNarrowPhase);
+        NarrowPhase();
+    }
+    stats_.step.narrow_phase_hits = static_cast<std::uint32_t>(overlapping_pairs_.size());
+    stats_.EndStep();
+
+    PROFILE_PLOT("bodies", objects_.size());
+    PROFILE_PLOT("pairs", potential_pairs_.size());
 }
 
 void TriggerSystem::UpdateShapes(const float delta_time)
 {
+    PROFILE_ZONE();
     for (auto& object : objects_)
     {
         auto& body = object.body();
         auto& collider = object.collider();
 
+        body.SaveStepStart();
         body.Update(delta_time);
 
         auto position = body.position();
 
         const float radius = object.radius();
 
-        //Check for collision with window borders
-        if (position.x - radius < 0)
+        //Check for collision with the world borders
+        if (position.x - radius < world_bounds_.min_bound().x)
         {
-            position.x = radius;
+            position.x = world_bounds_.min_bound().x + radius;
             body.set_velocity(math::Vec2f(-body.velocity().x, body.velocity().y));
         }
-        if(position.x + radius > 1200)
+        if(position.x + radius > world_bounds_.max_bound().x)
         {
-            position.x = 1200 - radius;
+            position.x = world_bounds_.max_bound().x - radius;
             body.set_velocity(math::Vec2f(-body.velocity().x, body.velocity().y));
         }
-        if (position.y - radius < 0)
+        if (position.y - radius < world_bounds_.min_bound().y)
         {
-            position.y = radius;
+            position.y = world_bounds_.min_bound().y + radius;
             body.set_velocity(math::Vec2f(body.velocity().x, -body.velocity().y));
         }
-        if(position.y + radius > 800)
+        if(position.y + radius > world_bounds_.max_bound().y)
         {
-            position.y = 800 - radius;
+            position.y = world_bounds_.max_bound().y - radius;
             body.set_velocity(math::Vec2f(body.velocity().x, -body.velocity().y));
         }
 
@@ -146,87 +189,52 @@ void TriggerSystem::UpdateShapes(const float delta_time)
 
 void TriggerSystem::SimplisticBroadPhase()
 {
-    std::unordered_map<GameObjectPair, bool> new_potential_pairs;
-
-    // Loop through all objects
-    for (size_t i = 0; i < objects_.size(); ++i)
-    {
-        auto& objectA = objects_[i];
-        auto& colliderA = objectA.collider();
-
-        // Get the AABB of the first collider
-        auto rangeA = colliderA.GetBoundingBox();
-
-        // Compare with all other objects
-        for (size_t j = i + 1; j < objects_.size(); ++j)
-        {
-            auto& objectB = objects_[j];
-            auto& colliderB = objectB.collider();
-
-            // Get the AABB of the second collider
-            auto rangeB = colliderB.GetBoundingBox();
-
-            // Check for AABB overlap
-            if (math::Intersect(rangeA, rangeB))
-            {
-                GameObjectPair pair{&objectA, &objectB};
-                new_potential_pairs[pair] = true;
-            }
-        }
-    }
-
-    // Update the potential pairs for narrow phase to process
-    potential_pairs_ = std::move(new_potential_pairs);
+    FindPairsBruteForce(objects_, potential_pairs_);
 }
 
-
-
 void TriggerSystem::BroadPhase()
 {
-    std::unordered_map<GameObjectPair, bool> new_potential_pairs;
-
-    quadtree_->Clear();
-    for (auto& object : objects_)
-    {
-        quadtree_->Insert(&object.collider());
-    }
+    FindPairs(objects_, *quadtree_, collider_to_object_map_, query_results_, stats_.step, potential_pairs_);
+}
 
-    // Use AABB tests for broad phase
-    for (auto& object : objects_)
+namespace
+{
+    //Runs a four wide overlap test over pairs, the last batch repeats its last pair in the unused lanes
+    template <typename Test>
+    void TestPairBatches(const std::vector<GameObjectPair>& pairs, const Test& test,
+                         std::unordered_set<GameObjectPair>& overlapping_pairs)
     {
-        auto& collider = object.collider();
-        // Get the AABB of the collider for broad phase test
-        auto range = collider.GetBoundingBox();
-        auto potentialColliders = quadtree_->Query(range);
-
-        for (auto& otherCollider : potentialColliders)
+        for (size_t first = 0; first < pairs.size(); first += 4)
         {
-            if (&collider != otherCollider)
+            const size_t count = std::min<size_t>(4, pairs.size() - first);
+            std::array<const GameObjectPair*, 4> batch{};
+            for (size_t lane = 0; lane < batch.size(); ++lane)
+            {
+                batch[lane] = &pairs[first + std::min(lane, count - 1)];
+            }
+
+            const int mask = test(batch);
+            for (size_t lane = 0; lane < count; ++lane)
             {
-                // Avoid self-collision
-                // Only test AABB overlap in broad phase
-                if (math::Intersect(range, otherCollider->GetBoundingBox()))
+                if (mask & (1 << lane))
                 {
-                    GameObject* objectA = collider_to_object_map_[&collider];
-                    GameObject* objectB = collider_to_object_map_[otherCollider];
-                    if (objectA && objectB)
-                    {
-                        GameObjectPair pair{objectA, objectB};
-                        new_potential_pairs[pair] = true;
-                    }
+                    overlapping_pairs.insert(*batch[lane]);
                 }
             }
         }
     }
-
-    // Update the potential pairs for narrow phase to process
-    potential_pairs_ = std::move(new_potential_pairs);
 }
 
+//Sensor pipeline, only overlaps are computed and their changes are recorded as events
 void TriggerSystem::NarrowPhase()
 {
-    std::unordered_set<GameObjectPair> newActivePairs;
+    PROFILE_ZONE();
+    overlapping_pairs_.clear();
+    circle_pairs_.clear();
+    aabb_pairs_.clear();
+    aabb_circle_pairs_.clear();
 
+    //Group the pairs by shape types, the other combinations are tested one by one
     for (const auto& pair : potential_pairs_ | std::views::keys)
     {
         if (!pair.gameObjectA_ || !pair.gameObjectB_)
@@ -234,104 +242,121 @@ void TriggerSystem::NarrowPhase()
             continue;
         }
 
-        const bool intersect = std::visit([](auto&& shape_a, auto&& shape_b)
-                                          {
-                                              return math::Intersect(shape_a, shape_b);
-                                          }, pair.gameObjectA_->collider().shape(),
-                                          pair.gameObjectB_->collider().shape());
-
-        if (intersect)
+        const auto type_a = pair.gameObjectA_->collider().GetShapeType();
+        const auto type_b = pair.gameObjectB_->collider().GetShapeType();
+        if (type_a == math::ShapeType::kCircle && type_b == math::ShapeType::kCircle)
         {
-            newActivePairs.insert(pair);
-
-            // If this is a new collision Keep for triggers?
-            if (active_pairs_.find(pair) == active_pairs_.end())
-            {
-                OnPairCollideStart(pair);
-            }
-            else
-            {
-                OnPairCollideStay(pair);
-            }
+            circle_pairs_.push_back(pair);
+        }
+        else if (type_a == math::ShapeType::kAABB && type_b == math::ShapeType::kAABB)
+        {
+            aabb_pairs_.push_back(pair);
+        }
+        else if (type_a == math::ShapeType::kAABB && type_b == math::ShapeType::kCircle)
+        {
+            aabb_circle_pairs_.push_back(pair);
+        }
+        else if (type_a == math::ShapeType::kCircle && type_b == math::ShapeType::kAABB)
+        {
+            aabb_circle_pairs_.push_back({pair.gameObjectB_, pair.gameObjectA_});
+        }
+        else if (physics::VisitShapes(pair.gameObjectA_->collider(), pair.gameObjectB_->collider(),
+                                      [](const auto& shape_a, const auto& shape_b)
+                                      {
+                                          return math::Intersect(shape_a, shape_b);
+                                      }))
+        {
+            overlapping_pairs_.insert(pair);
         }
     }
 
-    for (const auto& pair : active_pairs_)
+    TestPairBatches(circle_pairs_, [](const auto& batch)
     {
-        if (newActivePairs.find(pair) == newActivePairs.end())
+        math::FourVec2f centres_a, centres_b;
+        std::array<float, 4> radii_a{}, radii_b{};
+        for (size_t lane = 0; lane < batch.size(); ++lane)
         {
-            OnPairCollideEnd(pair);
+            const auto& circle_a = batch[lane]->gameObjectA_->collider().circle();
+            const auto& circle_b = batch[lane]->gameObjectB_->collider().circle();
+            centres_a.x[lane] = circle_a.centre().x;
+            centres_a.y[lane] = circle_a.centre().y;
+            centres_b.x[lane] = circle_b.centre().x;
+            centres_b.y[lane] = circle_b.centre().y;
+            radii_a[lane] = circle_a.radius();
+            radii_b[lane] = circle_b.radius();
         }
-    }
-    active_pairs_ = std::move(newActivePairs);
-}
-
-//Called on the first collision frame
-void TriggerSystem::OnPairCollideStart(const GameObjectPair& pair)
-{
-    if(!pair.gameObjectA_ || !pair.gameObjectB_){return;}
+        return math::IntersectFourCircles(centres_a, radii_a, centres_b, radii_b);
+    }, overlapping_pairs_);
 
-    pair.gameObjectA_->AddCollision();
-    pair.gameObjectB_->AddCollision();
-
-    if (pair.gameObjectA_->collider().is_trigger() || pair.gameObjectB_->collider().is_trigger())
-    {
-        pair.gameObjectA_->OnTriggerEnter();
-        pair.gameObjectB_->OnTriggerEnter();
-    }
-    else
+    TestPairBatches(aabb_pairs_, [](const auto& batch)
     {
-        physics::ContactSolver ContactSolver;
-        ContactSolver.SetContactObjects(pair);
-        ContactSolver.ResolveContact();
-        pair.gameObjectA_->OnCollisionEnter();
-        pair.gameObjectB_->OnCollisionEnter();
-    }
-}
-void TriggerSystem::OnPairCollideStay(const GameObjectPair& pair)
-{
-    if(!pair.gameObjectA_ || !pair.gameObjectB_){return;}
+        math::FourVec2f min_a, max_a, min_b, max_b;
+        for (size_t lane = 0; lane < batch.size(); ++lane)
+        {
+            const auto& aabb_a = batch[lane]->gameObjectA_->collider().aabb();
+            const auto& aabb_b = batch[lane]->gameObjectB_->collider().aabb();
+            min_a.x[lane] = aabb_a.min_bound().x;
+            min_a.y[lane] = aabb_a.min_bound().y;
+            max_a.x[lane] = aabb_a.max_bound().x;
+            max_a.y[lane] = aabb_a.max_bound().y;
+            min_b.x[lane] = aabb_b.min_bound().x;
+            min_b.y[lane] = aabb_b.min_bound().y;
+            max_b.x[lane] = aabb_b.max_bound().x;
+            max_b.y[lane] = aabb_b.max_bound().y;
+        }
+        return math::IntersectFourAABBs(min_a, max_a, min_b, max_b);
+    }, overlapping_pairs_);
 
-    if (pair.gameObjectA_->collider().is_trigger() || pair.gameObjectB_->collider().is_trigger())
-    {
-        pair.gameObjectA_->OnTriggerStay();
-        pair.gameObjectB_->OnTriggerStay();
-    }
-    else
+    TestPairBatches(aabb_circle_pairs_, [](const auto& batch)
     {
-        //pair.gameObjectA_->OnCollisionStay();
-        //pair.gameObjectB_->OnCollisionStay();
-    }
-}
-
-void TriggerSystem::OnPairCollideEnd(const GameObjectPair& pair)
-{
-    if (!pair.gameObjectA_ || !pair.gameObjectB_) return;
-
-    pair.gameObjectA_->SubCollision();
-    pair.gameObjectB_->SubCollision();
+        math::FourVec2f min, max, centres;
+        std::array<float, 4> radii{};
+        for (size_t lane = 0; lane < batch.size(); ++lane)
+        {
+            const auto& aabb = batch[lane]->gameObjectA_->collider().aabb();
+            const auto& circle = batch[lane]->gameObjectB_->collider().circle();
+            min.x[lane] = aabb.min_bound().x;
+            min.y[lane] = aabb.min_bound().y;
+            max.x[lane] = aabb.max_bound().x;
+            max.y[lane] = aabb.max_bound().y;
+            centres.x[lane] = circle.centre().x;
+            centres.y[lane] = circle.centre().y;
+            radii[lane] = circle.radius();
+        }
+        return math::IntersectFourAABBCircles(min, max, centres, radii);
+    }, overlapping_pairs_);
 
-    if (pair.gameObjectA_->collider().is_trigger() || pair.gameObjectB_->collider().is_trigger())
+    //Only the changes are recorded, no game code runs during the step
+    for (const auto& pair : overlapping_pairs_)
     {
-        if (pair.gameObjectA_->collisions_count() <= 0)
+        if (!active_pairs_.contains(pair))
         {
-            pair.gameObjectA_->OnTriggerExit();
+            trigger_events_.push_back({pair, TriggerEventType::kBegin});
         }
-        if (pair.gameObjectB_->collisions_count() <= 0)
+    }
+    for (const auto& pair : active_pairs_)
+    {
+        if (!overlapping_pairs_.contains(pair))
         {
-            pair.gameObjectB_->OnTriggerExit();
+            trigger_events_.push_back({pair, TriggerEventType::kEnd});
         }
     }
-    else
-    {
+    std::swap(active_pairs_, overlapping_pairs_);
+}
 
-        if (pair.gameObjectA_->collisions_count() <= 0)
+void TriggerSystem::DispatchTriggerEvents()
+{
+    PROFILE_ZONE();
+    for (const auto& event : trigger_events_)
+    {
+        if (event.type == TriggerEventType::kBegin)
         {
-            pair.gameObjectA_->OnCollisionExit();
+            OnPairCollideStart(event.pair);
         }
-        if (pair.gameObjectB_->collisions_count() <= 0)
+        else
         {
-            pair.gameObjectB_->OnCollisionExit();
+            OnPairCollideEnd(event.pair);
         }
     }
-}
\ No newline at end of file
+    trigger_events_.clear();
+}
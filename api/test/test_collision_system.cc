@@ -0,0 +1,72 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+
+#include "collision_system.h"
+#include "random.h"
+
+namespace
+{
+    constexpr float kFixedTimeStep = 1.0f / 60.0f;
+
+    bool HasEventOf(const CollisionSystem& collision_system, const GameObject* object)
+    {
+        for (const auto& event : collision_system.contact_events().events())
+        {
+            if (event.handle_a == object || event.handle_b == object)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+}
+
+//An unregistered object leaves no pair or event behind, so no later step reports a contact of it
+TEST(CollisionSystem, UnregisterDropsPairsAndEvents)
+{
+    common::rng::Seed(1);
+    CollisionSystem collision_system;
+    collision_system.Initialize();
+
+    GameObject* touching = nullptr;
+    for (int i = 0; i < 600 && !touching; ++i)
+    {
+        collision_system.Update(kFixedTimeStep);
+        if (!collision_system.contact_events().empty())
+        {
+            touching = collision_system.contact_events().events()[0].handle_a;
+        }
+    }
+    ASSERT_NE(touching, nullptr);
+
+    collision_system.UnregisterObject(*touching);
+    EXPECT_FALSE(HasEventOf(collision_system, touching));
+
+    collision_system.Update(kFixedTimeStep);
+    EXPECT_FALSE(HasEventOf(collision_system, touching));
+}
+
+//The speed sliders go down to zero, a step of no time leaves overlapping bodies where they are
+TEST(CollisionSystem, ZeroTimeStepKeepsPositionsFinite)
+{
+    common::rng::Seed(1);
+    CollisionSystem collision_system;
+    collision_system.set_object_count(2);
+    collision_system.Initialize();
+
+    math::Circle circle_a(math::Vec2f(100.0f, 100.0f), 10.0f);
+    math::Circle circle_b(math::Vec2f(105.0f, 100.0f), 10.0f);
+    collision_system.CreateObject(0, circle_a);
+    collision_system.CreateObject(1, circle_b);
+
+    collision_system.Update(0.0f);
+
+    for (const auto& object : collision_system.objects())
+    {
+        EXPECT_TRUE(std::isfinite(object.position().x));
+        EXPECT_TRUE(std::isfinite(object.position().y));
+    }
+    EXPECT_EQ(collision_system.objects()[0].position(), math::Vec2f(100.0f, 100.0f));
+    EXPECT_EQ(collision_system.objects()[1].position(), math::Vec2f(105.0f, 100.0f));
+}
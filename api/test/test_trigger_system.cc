@@ -0,0 +1,47 @@
+#include <gtest/gtest.h>
+
+#include "random.h"
+#include "trigger_system.h"
+
+namespace
+{
+    constexpr float kFixedTimeStep = 1.0f / 60.0f;
+
+    bool HasEventOf(const TriggerSystem& trigger_system, const GameObject* object)
+    {
+        for (const auto& event : trigger_system.trigger_events())
+        {
+            if (event.pair.gameObjectA_ == object || event.pair.gameObjectB_ == object)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+}
+
+//An unregistered object leaves no overlap or event behind, so no later step reports an overlap of it
+TEST(TriggerSystem, UnregisterDropsPairsAndEvents)
+{
+    common::rng::Seed(1);
+    TriggerSystem trigger_system;
+    trigger_system.set_object_count(40);
+    trigger_system.Initialize();
+
+    GameObject* overlapping = nullptr;
+    for (int i = 0; i < 600 && !overlapping; ++i)
+    {
+        trigger_system.Update(kFixedTimeStep);
+        if (!trigger_system.trigger_events().empty())
+        {
+            overlapping = trigger_system.trigger_events()[0].pair.gameObjectA_;
+        }
+    }
+    ASSERT_NE(overlapping, nullptr);
+
+    trigger_system.UnregisterObject(*overlapping);
+    EXPECT_FALSE(HasEventOf(trigger_system, overlapping));
+
+    trigger_system.Update(kFixedTimeStep);
+    EXPECT_FALSE(HasEventOf(trigger_system, overlapping));
+}
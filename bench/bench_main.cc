@@ -0,0 +1,27 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <string_view>
+#include <vector>
+
+//Entry point shared by the benchmark executables
+//Reports in JSON unless another format is asked for, so the results of two builds can be compared
+int main(int argc, char* argv[])
+{
+    std::vector<char*> arguments(argv, argv + argc);
+    char json_format[] = "--benchmark_format=json";
+    if (std::ranges::none_of(arguments, [](const std::string_view argument) { return argument.starts_with("--benchmark_format"); }))
+    {
+        arguments.push_back(json_format);
+    }
+
+    int argument_count = static_cast<int>(arguments.size());
+    benchmark::Initialize(&argument_count, arguments.data());
+    if (benchmark::ReportUnrecognizedArguments(argument_count, arguments.data()))
+    {
+        return 1;
+    }
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
@@ -0,0 +1,298 @@
+#include <benchmark/benchmark.h>
+
+#include <array>
+#include <cmath>
+#include <span>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+#include "four_vec2.h"
+#include "four_vec3.h"
+#include "four_vec4.h"
+#include "matrix2.h"
+#include "matrix3.h"
+#include "matrix4.h"
+#include "quaternion.h"
+#include "random.h"
+#include "vec2.h"
+#include "vec3.h"
+#include "vec4.h"
+
+//Throughput of the math types per operation, the items per second count single vectors whatever the layout
+//AoS runs the scalar Vec types, SoA runs plain float arrays, SIMD runs the SSE FourVec types on blocks of four
+//The small size stays in the L1 cache, the large one streams from memory
+
+namespace
+{
+    constexpr std::int64_t kCacheResidentCount = 1 << 10;
+    constexpr std::int64_t kStreamingCount = 1 << 22;
+    constexpr std::uint64_t kSeed = 1;
+
+    std::vector<float> RandomFloats(const std::size_t count, common::rng::Engine& engine)
+    {
+        std::vector<float> values(count);
+        engine.Fill(std::span<float>(values), -100.0f, 100.0f);
+        return values;
+    }
+
+    template <typename V>
+    constexpr int kDimension = sizeof(V) / sizeof(float);
+
+    template <typename V>
+    std::vector<V> RandomVectors(const std::size_t count, common::rng::Engine& engine)
+    {
+        std::vector<V> vectors(count);
+        for (auto& vector : vectors)
+        {
+            std::array<float, kDimension<V>> values{};
+            engine.Fill(std::span<float>(values), -100.0f, 100.0f);
+            vector = std::apply([](const auto... components) { return V(components...); }, values);
+        }
+        return vectors;
+    }
+
+    //Four scalar vectors packed per SIMD vector
+    template <typename FourV, typename V>
+    std::vector<FourV> RandomFourVectors(const std::size_t count, common::rng::Engine& engine)
+    {
+        const std::vector<V> vectors = RandomVectors<V>(count, engine);
+        std::vector<FourV> packed(count / 4);
+        for (std::size_t i = 0; i < packed.size(); ++i)
+        {
+            packed[i] = FourV(std::array<V, 4>{vectors[4 * i], vectors[4 * i + 1], vectors[4 * i + 2], vectors[4 * i + 3]});
+        }
+        return packed;
+    }
+
+    struct AddOp
+    {
+        template <typename V>
+        auto operator()(const V& a, const V& b) const { return a + b; }
+    };
+
+    struct DotOp
+    {
+        template <typename V>
+        auto operator()(const V& a, const V& b) const
+        {
+            if constexpr (requires { V::Dot(a, b); })
+                return V::Dot(a, b);
+            else
+                return a.Dot(b);
+        }
+    };
+
+    struct MagnitudeOp
+    {
+        template <typename V>
+        auto operator()(const V& a, const V&) const { return a.Magnitude(); }
+    };
+
+    struct NormalizeOp
+    {
+        template <typename V>
+        auto operator()(const V& a, const V&) const
+        {
+            if constexpr (requires { a.Normalized(); })
+                return a.Normalized();
+            else
+                return a.Normalize();
+        }
+    };
+
+    //Same operation for the AoS scalar types and the SIMD types, the inputs hold state.range(0) vectors
+    template <typename V, typename Op>
+    void RunPacked(benchmark::State& state, const std::vector<V>& a, const std::vector<V>& b, const std::int64_t vectors_per_item)
+    {
+        using Result = decltype(Op()(a[0], b[0]));
+        std::vector<Result> results(a.size());
+        const Op op;
+
+        for (auto _ : state)
+        {
+            for (std::size_t i = 0; i < a.size(); ++i)
+            {
+                results[i] = op(a[i], b[i]);
+            }
+            benchmark::DoNotOptimize(results.data());
+            benchmark::ClobberMemory();
+        }
+        state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(a.size()) * vectors_per_item);
+    }
+
+    template <typename V, typename Op>
+    void BM_AoS(benchmark::State& state)
+    {
+        common::rng::Engine engine(kSeed);
+        const auto a = RandomVectors<V>(static_cast<std::size_t>(state.range(0)), engine);
+        const auto b = RandomVectors<V>(static_cast<std::size_t>(state.range(0)), engine);
+        RunPacked<V, Op>(state, a, b, 1);
+    }
+
+    template <typename FourV, typename V, typename Op>
+    void BM_SIMD(benchmark::State& state)
+    {
+        common::rng::Engine engine(kSeed);
+        const auto a = RandomFourVectors<FourV, V>(static_cast<std::size_t>(state.range(0)), engine);
+        const auto b = RandomFourVectors<FourV, V>(static_cast<std::size_t>(state.range(0)), engine);
+        RunPacked<FourV, Op>(state, a, b, 4);
+    }
+
+    //One float array per component, each pass runs over one component so the compiler is free to vectorize it
+    template <int N, typename Op>
+    void BM_SoA(benchmark::State& state)
+    {
+        common::rng::Engine engine(kSeed);
+        const auto count = static_cast<std::size_t>(state.range(0));
+        std::array<std::vector<float>, N> a;
+        std::array<std::vector<float>, N> b;
+        std::array<std::vector<float>, N> results;
+        for (int c = 0; c < N; ++c)
+        {
+            a[c] = RandomFloats(count, engine);
+            b[c] = RandomFloats(count, engine);
+            results[c].resize(count);
+        }
+
+        for (auto _ : state)
+        {
+            if constexpr (std::is_same_v<Op, AddOp>)
+            {
+                for (int c = 0; c < N; ++c)
+                {
+                    const float* lhs = a[c].data();
+                    const float* rhs = b[c].data();
+                    float* result = results[c].data();
+                    for (std::size_t i = 0; i < count; ++i)
+                    {
+                        result[i] = lhs[i] + rhs[i];
+                    }
+                }
+            }
+            else
+            {
+                //Dot products, or square magnitudes, summed component by component in the first result array
+                float* sum = results[0].data();
+                for (int c = 0; c < N; ++c)
+                {
+                    const float* lhs = a[c].data();
+                    const float* rhs = std::is_same_v<Op, DotOp> ? b[c].data() : a[c].data();
+                    for (std::size_t i = 0; i < count; ++i)
+                    {
+                        sum[i] = (c == 0 ? 0.0f : sum[i]) + lhs[i] * rhs[i];
+                    }
+                }
+
+                if constexpr (std::is_same_v<Op, MagnitudeOp>)
+                {
+                    for (std::size_t i = 0; i < count; ++i)
+                    {
+                        sum[i] = std::sqrt(sum[i]);
+                    }
+                }
+                else if constexpr (std::is_same_v<Op, NormalizeOp>)
+                {
+                    for (std::size_t i = 0; i < count; ++i)
+                    {
+                        sum[i] = 1.0f / std::sqrt(sum[i]);
+                    }
+                    //The last component goes first, the first one overwrites the inverse magnitudes
+                    for (int c = N - 1; c >= 0; --c)
+                    {
+                        const float* components = a[c].data();
+                        float* result = results[c].data();
+                        for (std::size_t i = 0; i < count; ++i)
+                        {
+                            result[i] = components[i] * sum[i];
+                        }
+                    }
+                }
+            }
+            for (auto& result : results)
+            {
+                benchmark::DoNotOptimize(result.data());
+            }
+            benchmark::ClobberMemory();
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+
+    //Matrix times vector and quaternion products only exist as scalar code
+    template <typename M, typename V>
+    void BM_MatrixVector(benchmark::State& state)
+    {
+        common::rng::Engine engine(kSeed);
+        const auto vectors = RandomVectors<V>(static_cast<std::size_t>(state.range(0)), engine);
+        const auto rows = RandomVectors<V>(kDimension<V>, engine);
+        M matrix{};
+        for (int r = 0; r < kDimension<V>; ++r)
+        {
+            matrix[r] = rows[r];
+        }
+        std::vector<V> results(vectors.size());
+
+        for (auto _ : state)
+        {
+            for (std::size_t i = 0; i < vectors.size(); ++i)
+            {
+                results[i] = matrix * vectors[i];
+            }
+            benchmark::DoNotOptimize(results.data());
+            benchmark::ClobberMemory();
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+
+    void BM_QuaternionProduct(benchmark::State& state)
+    {
+        common::rng::Engine engine(kSeed);
+        const auto count = static_cast<std::size_t>(state.range(0));
+        std::vector<math::Quaternion<float>> a(count);
+        std::vector<math::Quaternion<float>> b(count);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            a[i] = math::Quaternion<float>(engine.Range(-1.0f, 1.0f), engine.Range(-1.0f, 1.0f), engine.Range(-1.0f, 1.0f), engine.Range(-1.0f, 1.0f));
+            b[i] = math::Quaternion<float>(engine.Range(-1.0f, 1.0f), engine.Range(-1.0f, 1.0f), engine.Range(-1.0f, 1.0f), engine.Range(-1.0f, 1.0f));
+        }
+        std::vector<math::Quaternion<float>> results(count);
+
+        for (auto _ : state)
+        {
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                results[i] = a[i] * b[i];
+            }
+            benchmark::DoNotOptimize(results.data());
+            benchmark::ClobberMemory();
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+
+    using Vec2f = math::Vec2<float>;
+    using Vec3f = math::Vec3<float>;
+    using Vec4f = math::Vec4<float>;
+}
+
+#define KUMA_MATH_BENCHMARK(...) BENCHMARK_TEMPLATE(__VA_ARGS__)->Arg(kCacheResidentCount)->Arg(kStreamingCount)
+
+#define KUMA_MATH_BENCHMARK_OP(Op)                                    \
+    KUMA_MATH_BENCHMARK(BM_AoS, Vec2f, Op);                           \
+    KUMA_MATH_BENCHMARK(BM_SoA, 2, Op);                               \
+    KUMA_MATH_BENCHMARK(BM_SIMD, math::FourVec2f, Vec2f, Op);         \
+    KUMA_MATH_BENCHMARK(BM_AoS, Vec3f, Op);                           \
+    KUMA_MATH_BENCHMARK(BM_SoA, 3, Op);                               \
+    KUMA_MATH_BENCHMARK(BM_SIMD, math::FourVec3f, Vec3f, Op);         \
+    KUMA_MATH_BENCHMARK(BM_AoS, Vec4f, Op);                           \
+    KUMA_MATH_BENCHMARK(BM_SoA, 4, Op);                               \
+    KUMA_MATH_BENCHMARK(BM_SIMD, math::FourVec4f, Vec4f, Op)
+
+KUMA_MATH_BENCHMARK_OP(AddOp);
+KUMA_MATH_BENCHMARK_OP(DotOp);
+KUMA_MATH_BENCHMARK_OP(MagnitudeOp);
+KUMA_MATH_BENCHMARK_OP(NormalizeOp);
+
+KUMA_MATH_BENCHMARK(BM_MatrixVector, math::matrix2<float>, Vec2f);
+KUMA_MATH_BENCHMARK(BM_MatrixVector, math::matrix3<float>, Vec3f);
+KUMA_MATH_BENCHMARK(BM_MatrixVector, math::matrix4<float>, Vec4f);
+BENCHMARK(BM_QuaternionProduct)->Arg(kCacheResidentCount)->Arg(kStreamingCount);
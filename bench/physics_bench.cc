@@ -0,0 +1,242 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "collision_system.h"
+#include "friction_system.h"
+#include "graphics_manager.h"
+#include "planet_system.h"
+#include "random.h"
+#include "timer.h"
+#include "trigger_system.h"
+
+namespace
+{
+    constexpr std::int64_t kMinBodies = 200;
+    constexpr std::int64_t kMaxBodies = 1'000'000;
+    //The all-pairs broad phase and the friction stacks grow quadratically, they stop earlier
+    constexpr std::int64_t kMaxQuadraticBodies = 10'000;
+    constexpr std::int64_t kMaxFrictionBodies = 1'000;
+    constexpr std::uint64_t kSeed = 1;
+
+    const float kFixedTimeStep = Timer().FixedDeltaTime();
+
+    //World grown with the body count so every size keeps the density of the 200 bodies scene
+    math::Bounds2f WorldBounds(const std::int64_t body_count)
+    {
+        const float scale = std::max(1.0f, std::sqrt(static_cast<float>(body_count) / static_cast<float>(kMinBodies)));
+        return {math::Vec2f::Zero(), math::Vec2f(kWindowWidth * scale, kWindowHeight * scale)};
+    }
+
+    void InitializeCollisionScene(CollisionSystem& collision_system, const std::int64_t body_count)
+    {
+        common::rng::Seed(kSeed);
+        collision_system.set_object_count(static_cast<std::size_t>(body_count));
+        collision_system.set_world_bounds(WorldBounds(body_count));
+        collision_system.solver_settings().deterministic = true;
+        collision_system.Initialize();
+        collision_system.world().PredictMotion(collision_system.objects(), kFixedTimeStep);
+    }
+
+    void BM_PlanetUpdatePlanets(benchmark::State& state)
+    {
+        common::rng::Seed(kSeed);
+        PlanetSystem planet_system;
+        planet_system.set_planet_count(static_cast<std::size_t>(state.range(0)));
+        planet_system.Initialize();
+
+        for (auto _ : state)
+        {
+            planet_system.UpdatePlanets(kFixedTimeStep * 1000.0f);
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+    BENCHMARK(BM_PlanetUpdatePlanets)->RangeMultiplier(10)->Range(kMinBodies, kMaxBodies)->Unit(benchmark::kMicrosecond);
+
+    void BM_PlanetUpdatePlanetsSIMD(benchmark::State& state)
+    {
+        common::rng::Seed(kSeed);
+        PlanetSystem planet_system;
+        planet_system.set_planet_count(static_cast<std::size_t>(state.range(0)));
+        planet_system.Initialize();
+
+        for (auto _ : state)
+        {
+            planet_system.UpdatePlanetsSIMD(kFixedTimeStep * 1000.0f);
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+    BENCHMARK(BM_PlanetUpdatePlanetsSIMD)->RangeMultiplier(10)->Range(kMinBodies, kMaxBodies)->Unit(benchmark::kMicrosecond);
+
+    void BM_CollisionSimplisticBroadPhase(benchmark::State& state)
+    {
+        CollisionSystem collision_system;
+        InitializeCollisionScene(collision_system, state.range(0));
+
+        for (auto _ : state)
+        {
+            collision_system.world().SimplisticBroadPhase(collision_system.objects());
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+    BENCHMARK(BM_CollisionSimplisticBroadPhase)->RangeMultiplier(10)->Range(kMinBodies, kMaxQuadraticBodies)->Unit(benchmark::kMillisecond);
+
+    void BM_CollisionBroadPhase(benchmark::State& state)
+    {
+        CollisionSystem collision_system;
+        InitializeCollisionScene(collision_system, state.range(0));
+
+        for (auto _ : state)
+        {
+            collision_system.world().BroadPhase(collision_system.objects());
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+    BENCHMARK(BM_CollisionBroadPhase)->RangeMultiplier(10)->Range(kMinBodies, kMaxBodies)->Unit(benchmark::kMillisecond);
+
+    void BM_CollisionNarrowPhase(benchmark::State& state)
+    {
+        CollisionSystem collision_system;
+        InitializeCollisionScene(collision_system, state.range(0));
+        collision_system.world().BroadPhase(collision_system.objects());
+        collision_system.world().OrderPairs();
+
+        for (auto _ : state)
+        {
+            collision_system.world().NarrowPhase();
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+    BENCHMARK(BM_CollisionNarrowPhase)->RangeMultiplier(10)->Range(kMinBodies, kMaxBodies)->Unit(benchmark::kMillisecond);
+
+    //Every iteration solves the same contacts, the bodies are put back and the contacts rebuilt outside of the timing
+    void BM_CollisionSolveContacts(benchmark::State& state)
+    {
+        CollisionSystem collision_system;
+        InitializeCollisionScene(collision_system, state.range(0));
+        collision_system.world().BroadPhase(collision_system.objects());
+        collision_system.world().OrderPairs();
+        const std::vector<GameObject> initial_objects(collision_system.objects().begin(), collision_system.objects().end());
+
+        for (auto _ : state)
+        {
+            state.PauseTiming();
+            std::ranges::copy(initial_objects, collision_system.objects().begin());
+            collision_system.world().NarrowPhase();
+            state.ResumeTiming();
+
+            collision_system.world().SolveContacts(kFixedTimeStep);
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+    BENCHMARK(BM_CollisionSolveContacts)->RangeMultiplier(10)->Range(kMinBodies, kMaxBodies)->Unit(benchmark::kMillisecond);
+
+    void BM_CollisionUpdate(benchmark::State& state)
+    {
+        CollisionSystem collision_system;
+        InitializeCollisionScene(collision_system, state.range(0));
+
+        for (auto _ : state)
+        {
+            collision_system.Update(kFixedTimeStep);
+            collision_system.DispatchContactEvents();
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+    BENCHMARK(BM_CollisionUpdate)->RangeMultiplier(10)->Range(kMinBodies, kMaxBodies)->Unit(benchmark::kMillisecond);
+
+    void BM_TriggerUpdate(benchmark::State& state)
+    {
+        common::rng::Seed(kSeed);
+        TriggerSystem trigger_system;
+        trigger_system.set_object_count(static_cast<std::size_t>(state.range(0)));
+        trigger_system.set_world_bounds(WorldBounds(state.range(0) / 2));
+        trigger_system.Initialize();
+
+        for (auto _ : state)
+        {
+            trigger_system.Update(kFixedTimeStep);
+            trigger_system.DispatchTriggerEvents();
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+    BENCHMARK(BM_TriggerUpdate)->RangeMultiplier(10)->Range(kMinBodies, kMaxBodies)->Unit(benchmark::kMillisecond);
+
+    //Bodies dropped in rows over the ground, timed while they fall and settle
+    void BM_FrictionUpdate(benchmark::State& state)
+    {
+        common::rng::Seed(kSeed);
+        FrictionSystem friction_system;
+        friction_system.set_object_capacity(static_cast<std::size_t>(state.range(0)) + 1);
+        friction_system.solver_settings().deterministic = true;
+        friction_system.Initialize();
+
+        constexpr std::int64_t kColumns = 12;
+        constexpr math::ShapeType kTypes[] = {math::ShapeType::kCircle, math::ShapeType::kAABB, math::ShapeType::kPolygon};
+        for (std::int64_t i = 0; i < state.range(0); ++i)
+        {
+            const math::Vec2f position(380.0f + static_cast<float>(i % kColumns) * 40.0f, 600.0f - static_cast<float>(i / kColumns) * 40.0f);
+            friction_system.SpawnShape(position, kTypes[i % 3]);
+        }
+
+        for (auto _ : state)
+        {
+            friction_system.Update(kFixedTimeStep * 4.0f);
+            friction_system.DispatchContactEvents();
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+    BENCHMARK(BM_FrictionUpdate)->RangeMultiplier(5)->Range(kMinBodies, kMaxFrictionBodies)->Unit(benchmark::kMillisecond);
+
+    //Render geometry of the planets, one circle at a time against the batched circles
+    void BM_GraphicsCreateCircle(benchmark::State& state)
+    {
+        common::rng::Seed(kSeed);
+        PlanetSystem planet_system;
+        planet_system.set_planet_count(static_cast<std::size_t>(state.range(0)));
+        planet_system.Initialize();
+        GraphicsManager graphics_manager;
+
+        for (auto _ : state)
+        {
+            graphics_manager.Clear();
+            for (const auto& planet : planet_system.planets())
+            {
+                graphics_manager.CreateCircle(planet.position(), planet.radius(), planet.color(), false);
+            }
+            benchmark::DoNotOptimize(graphics_manager.vertices().data());
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+    BENCHMARK(BM_GraphicsCreateCircle)->RangeMultiplier(10)->Range(kMinBodies, kMaxBodies)->Unit(benchmark::kMicrosecond);
+
+    void BM_GraphicsCreateCircles(benchmark::State& state)
+    {
+        common::rng::Seed(kSeed);
+        PlanetSystem planet_system;
+        planet_system.set_planet_count(static_cast<std::size_t>(state.range(0)));
+        planet_system.Initialize();
+        GraphicsManager graphics_manager;
+
+        std::vector<math::Vec2f> centres;
+        std::vector<float> radii;
+        std::vector<SDL_Color> colors;
+        for (const auto& planet : planet_system.planets())
+        {
+            centres.push_back(planet.position());
+            radii.push_back(planet.radius());
+            colors.push_back(planet.color());
+        }
+
+        for (auto _ : state)
+        {
+            graphics_manager.Clear();
+            graphics_manager.CreateCircles(centres, radii, colors);
+            benchmark::DoNotOptimize(graphics_manager.vertices().data());
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+    BENCHMARK(BM_GraphicsCreateCircles)->RangeMultiplier(10)->Range(kMinBodies, kMaxBodies)->Unit(benchmark::kMicrosecond);
+}
@@ -0,0 +1,190 @@
+#include <algorithm>
+#include <charconv>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <string_view>
+
+#include "collision_system.h"
+#include "friction_system.h"
+#include "planet_system.h"
+#include "profiler.h"
+#include "random.h"
+#include "stats.h"
+#include "timer.h"
+#include "trigger_system.h"
+
+//Steps one scene for a number of fixed ticks without a window, a renderer or ImGui, and prints where the time went
+//Usage: headless [--scene planet|trigger|collision|friction] [--count bodies] [--seed seed] [--ticks ticks]
+
+namespace
+{
+    struct Options
+    {
+        std::string_view scene = "collision";
+        std::size_t count = 200;
+        std::uint64_t seed = common::rng::Engine::kDefaultSeed;
+        std::size_t ticks = 600;
+    };
+
+    template <typename T>
+    bool ParseNumber(const std::string_view text, T& value)
+    {
+        const auto [end, error] = std::from_chars(text.data(), text.data() + text.size(), value);
+        return error == std::errc() && end == text.data() + text.size();
+    }
+
+    bool ParseOptions(const int argc, char* argv[], Options& options)
+    {
+        for (int i = 1; i + 1 < argc; i += 2)
+        {
+            const std::string_view name = argv[i];
+            const std::string_view value = argv[i + 1];
+
+            bool valid = false;
+            if (name == "--scene")
+            {
+                options.scene = value;
+                valid = value == "planet" || value == "trigger" || value == "collision" || value == "friction";
+            }
+            else if (name == "--count")
+            {
+                valid = ParseNumber(value, options.count);
+            }
+            else if (name == "--seed")
+            {
+                valid = ParseNumber(value, options.seed);
+            }
+            else if (name == "--ticks")
+            {
+                valid = ParseNumber(value, options.ticks);
+            }
+
+            if (!valid)
+            {
+                std::cerr << "Invalid option " << name << " " << value << "\n";
+                return false;
+            }
+        }
+        return argc % 2 == 1;
+    }
+
+    void PrintStats(const Options& options, const physics::Stats& stats, const double total_seconds, const std::uint64_t step_hash)
+    {
+        const double tick_count = static_cast<double>(std::max<std::uint64_t>(stats.step_count, 1));
+
+        std::cout << "scene " << options.scene << ", " << options.count << " bodies, " << options.ticks
+                  << " ticks, seed " << options.seed << "\n";
+        std::cout << std::left << std::setw(24) << "phase" << std::right << std::setw(12) << "total ms"
+                  << std::setw(14) << "per tick us" << "\n";
+        std::cout << std::fixed << std::setprecision(3);
+        for (std::size_t i = 0; i < physics::kPhaseCount; ++i)
+        {
+            std::cout << std::left << std::setw(24) << physics::kPhaseNames[i] << std::right << std::setw(12)
+                      << stats.phase_seconds[i] * 1000.0 << std::setw(14) << stats.phase_seconds[i] * 1e6 / tick_count << "\n";
+        }
+        std::cout << std::left << std::setw(24) << "step" << std::right << std::setw(12) << total_seconds * 1000.0
+                  << std::setw(14) << total_seconds * 1e6 / tick_count << "\n";
+
+        const physics::StepCounters& last_step = stats.last_step;
+        std::cout << "last step: " << last_step.candidate_pairs << " pairs, " << last_step.narrow_phase_hits << " hits, "
+                  << last_step.quadtree_nodes << " nodes (depth " << last_step.quadtree_depth << "), "
+                  << last_step.quadtree_queries << " queries, " << last_step.solver_iterations << " iterations\n";
+
+        if (step_hash != 0)
+        {
+            std::cout << "step hash " << std::hex << std::setw(16) << std::setfill('0') << step_hash << "\n";
+        }
+    }
+
+    //Times the ticks as a whole and prints them with the phase timings of the scene
+    template <typename Scene, typename Step>
+    void Run(const Options& options, Scene& scene, Step&& step)
+    {
+        Timer timer;
+        for (std::size_t tick = 0; tick < options.ticks; ++tick)
+        {
+            step();
+            PROFILE_FRAME();
+        }
+        const float total_seconds = timer.TotalTime();
+
+        std::uint64_t step_hash = 0;
+        if constexpr (requires { scene.step_hash(); })
+        {
+            step_hash = scene.step_hash();
+        }
+        PrintStats(options, scene.stats(), total_seconds, step_hash);
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    Options options;
+    if (!ParseOptions(argc, argv, options))
+    {
+        std::cerr << "Usage: headless [--scene planet|trigger|collision|friction] [--count bodies] [--seed seed] [--ticks ticks]\n";
+        return 1;
+    }
+
+    //Same fixed step as GameEngine, with the same per-scene time scales
+    const float fixed_time_step = Timer().FixedDeltaTime();
+    common::rng::Seed(options.seed);
+
+    if (options.scene == "planet")
+    {
+        PlanetSystem planet_system;
+        planet_system.set_planet_count(options.count);
+        planet_system.Initialize();
+        Run(options, planet_system, [&] { planet_system.Update(fixed_time_step * 1000.0f, SDL_Color{255, 13, 132, 255}); });
+    }
+    else if (options.scene == "trigger")
+    {
+        TriggerSystem trigger_system;
+        trigger_system.set_object_count(options.count);
+        trigger_system.Initialize();
+        Run(options, trigger_system, [&]
+        {
+            trigger_system.Update(fixed_time_step);
+            trigger_system.DispatchTriggerEvents();
+        });
+    }
+    else if (options.scene == "collision")
+    {
+        CollisionSystem collision_system;
+        collision_system.set_object_count(options.count);
+        collision_system.solver_settings().deterministic = true;
+        collision_system.Initialize();
+        Run(options, collision_system, [&]
+        {
+            collision_system.Update(fixed_time_step);
+            collision_system.DispatchContactEvents();
+        });
+    }
+    else
+    {
+        FrictionSystem friction_system;
+        friction_system.set_object_capacity(options.count + 1);
+        friction_system.solver_settings().deterministic = true;
+        friction_system.Initialize();
+
+        //Rows of circles, boxes and polygons stacked above the ground
+        constexpr std::size_t kColumns = 30;
+        constexpr float kSpacing = 40.0f;
+        for (std::size_t i = 0; i < options.count; ++i)
+        {
+            const math::Vec2f position(20.0f + static_cast<float>(i % kColumns) * kSpacing,
+                                       600.0f - static_cast<float>(i / kColumns) * kSpacing);
+            constexpr math::ShapeType kTypes[] = {math::ShapeType::kCircle, math::ShapeType::kAABB, math::ShapeType::kPolygon};
+            friction_system.SpawnShape(position, kTypes[i % 3]);
+        }
+
+        Run(options, friction_system, [&]
+        {
+            friction_system.Update(fixed_time_step * 4.0f);
+            friction_system.DispatchContactEvents();
+        });
+    }
+
+    return 0;
+}
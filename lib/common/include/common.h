@@ -12,5 +12,29 @@ namespace common
         return abs(value - target) <= Epsilon;
     }
 
+    //Sine usable in constant expressions, for tables built at compile time, std::sin is not constexpr
+    //The angle is brought into [-Pi, Pi] and the Taylor series summed in double, within a float ulp or two of std::sin
+    [[nodiscard]] constexpr float Sin(const float angle)
+    {
+        constexpr double kPi = 3.14159265358979323846;
+        double x = angle;
+        while (x > kPi) { x -= 2.0 * kPi; }
+        while (x < -kPi) { x += 2.0 * kPi; }
+
+        double term = x;
+        double sum = x;
+        for (int n = 1; n < 12; ++n)
+        {
+            term *= -x * x / static_cast<double>((2 * n) * (2 * n + 1));
+            sum += term;
+        }
+        return static_cast<float>(sum);
+    }
+
+    [[nodiscard]] constexpr float Cos(const float angle)
+    {
+        return Sin(angle + Pi * 0.5f);
+    }
+
 } // namespace math
 #endif // KUMA_ENGINE_LIB_COMMON_COMMON_H_
@@ -0,0 +1,35 @@
+#ifndef KUMA_ENGINE_LIB_COMMON_PROFILER_H_
+#define KUMA_ENGINE_LIB_COMMON_PROFILER_H_
+
+//Tracy zones and plots, they compile to nothing unless the build defines TRACE_ENABLE (ENABLE_PROFILING in CMake)
+
+#ifdef TRACE_ENABLE
+
+#include <cstdint>
+
+#include <tracy/Tracy.hpp>
+
+#define PROFILE_FRAME() FrameMark
+#define PROFILE_ZONE() ZoneScoped
+#define PROFILE_ZONE_NAMED(name) ZoneScopedN(name)
+#define PROFILE_PLOT(name, value) TracyPlot(name, static_cast<int64_t>(value))
+
+namespace common
+{
+    //Heap allocations made since the last call, counted by the operator new of the profiling builds
+    [[nodiscard]] std::int64_t TakeAllocationCount();
+}
+
+#define PROFILE_PLOT_ALLOCATIONS() TracyPlot("allocations", common::TakeAllocationCount())
+
+#else
+
+#define PROFILE_FRAME()
+#define PROFILE_ZONE()
+#define PROFILE_ZONE_NAMED(name)
+#define PROFILE_PLOT(name, value)
+#define PROFILE_PLOT_ALLOCATIONS()
+
+#endif
+
+#endif //KUMA_ENGINE_LIB_COMMON_PROFILER_H_
@@ -1,27 +1,153 @@
 ﻿#ifndef KUMA_ENGINE_LIB_COMMON_RANDOM_H_
 #define KUMA_ENGINE_LIB_COMMON_RANDOM_H_
 
+#include <array>
+#include <cassert>
+#include <cstdint>
+#include <limits>
 #include <random>
+#include <span>
+#include <type_traits>
 
-namespace random
+namespace common::rng
 {
-    template <typename T>
-    [[nodiscard]] T Range(const T min_number, const T max_number)
+    //xoshiro128** generator, 16 bytes of state and a few instructions per number
+    //Satisfies UniformRandomBitGenerator so it can also feed the std distributions
+    class Engine
     {
-        static_assert(std::is_arithmetic_v<T>, "T must be arithmetic type");
+    private:
+        std::array<std::uint32_t, 4> state_{};
 
-        std::mt19937 rng(std::random_device{}());
-        if constexpr (std::is_integral_v<T>)
+        [[nodiscard]] static constexpr std::uint32_t RotateLeft(const std::uint32_t x, const int k)
         {
-            std::uniform_int_distribution<int> dist(min_number, max_number);
-            return dist(rng);
+            return (x << k) | (x >> (32 - k));
         }
-        else if constexpr (std::is_floating_point_v<T>)
+
+    public:
+        using result_type = std::uint32_t;
+
+        static constexpr std::uint64_t kDefaultSeed = 0x853C49E6748FEA9Bull;
+
+        constexpr explicit Engine(const std::uint64_t seed = kDefaultSeed) { Seed(seed); }
+
+        //Expands the seed with splitmix64, so close seeds still give unrelated sequences
+        constexpr void Seed(std::uint64_t seed)
         {
-            std::uniform_real_distribution<float> dist(min_number, max_number);
-            return dist(rng);
+            for (std::size_t i = 0; i < state_.size(); i += 2)
+            {
+                seed += 0x9E3779B97F4A7C15ull;
+                std::uint64_t z = seed;
+                z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+                z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+                z ^= z >> 31;
+                state_[i] = static_cast<std::uint32_t>(z);
+                state_[i + 1] = static_cast<std::uint32_t>(z >> 32);
+            }
         }
-        throw std::invalid_argument("Invalid type");
+
+        [[nodiscard]] static constexpr result_type min() { return 0; }
+        [[nodiscard]] static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+        constexpr result_type operator()()
+        {
+            const std::uint32_t result = RotateLeft(state_[1] * 5, 7) * 9;
+            const std::uint32_t t = state_[1] << 9;
+
+            state_[2] ^= state_[0];
+            state_[3] ^= state_[1];
+            state_[1] ^= state_[2];
+            state_[0] ^= state_[3];
+            state_[2] ^= t;
+            state_[3] = RotateLeft(state_[3], 11);
+
+            return result;
+        }
+
+        //Integers are drawn in [min, max] and floating points in [min, max), like the std distributions
+        template <typename T>
+        [[nodiscard]] constexpr T Range(const T min_number, const T max_number)
+        {
+            static_assert(std::is_arithmetic_v<T>, "T must be arithmetic type");
+            assert(min_number <= max_number && "Range needs min_number <= max_number");
+
+            if constexpr (std::is_integral_v<T>)
+            {
+                //Lemire's multiply and reject, unbiased without a division in the common case
+                const std::uint64_t span = static_cast<std::uint64_t>(max_number) - static_cast<std::uint64_t>(min_number) + 1;
+                assert(span - 1 <= std::numeric_limits<std::uint32_t>::max() && "Integer ranges are limited to 32 bits");
+                if (span > std::numeric_limits<std::uint32_t>::max())
+                {
+                    return static_cast<T>(static_cast<std::uint64_t>(min_number) + (*this)());
+                }
+
+                std::uint64_t product = static_cast<std::uint64_t>((*this)()) * span;
+                if (static_cast<std::uint32_t>(product) < span)
+                {
+                    const auto threshold = static_cast<std::uint32_t>((0x100000000ull - span) % span);
+                    while (static_cast<std::uint32_t>(product) < threshold)
+                    {
+                        product = static_cast<std::uint64_t>((*this)()) * span;
+                    }
+                }
+                return static_cast<T>(static_cast<std::uint64_t>(min_number) + (product >> 32));
+            }
+            else if constexpr (std::is_same_v<T, float>)
+            {
+                const float unit = static_cast<float>((*this)() >> 8) * 0x1.0p-24f;
+                return min_number + (max_number - min_number) * unit;
+            }
+            else
+            {
+                const std::uint64_t bits = (static_cast<std::uint64_t>((*this)()) << 32) | (*this)();
+                const T unit = static_cast<T>(bits >> 11) * static_cast<T>(0x1.0p-53);
+                return min_number + (max_number - min_number) * unit;
+            }
+        }
+
+        //Fills values with numbers of Range, for spawning many objects at once
+        template <typename T>
+        constexpr void Fill(const std::span<T> values, const T min_number, const T max_number)
+        {
+            //A local copy keeps the state in registers for the whole loop
+            Engine engine = *this;
+            for (T& value : values)
+            {
+                value = engine.Range(min_number, max_number);
+            }
+            *this = engine;
+        }
+    };
+
+    //Seed drawn from the system, for runs that should not repeat
+    [[nodiscard]] inline std::uint64_t SystemSeed()
+    {
+        std::random_device device;
+        return (static_cast<std::uint64_t>(device()) << 32) | device();
+    }
+
+    //Engine of the calling thread, seeded from the system once per thread until Seed is called
+    [[nodiscard]] inline Engine& ThreadEngine()
+    {
+        thread_local Engine engine(SystemSeed());
+        return engine;
+    }
+
+    //Reseeds the engine of the calling thread, to replay the same sequence
+    inline void Seed(const std::uint64_t seed)
+    {
+        ThreadEngine().Seed(seed);
+    }
+
+    template <typename T>
+    [[nodiscard]] T Range(const T min_number, const T max_number)
+    {
+        return ThreadEngine().Range(min_number, max_number);
+    }
+
+    template <typename T>
+    void Fill(const std::span<T> values, const T min_number, const T max_number)
+    {
+        ThreadEngine().Fill(values, min_number, max_number);
     }
 }
 #endif //KUMA_ENGINE_LIB_COMMON_RANDOM_H_
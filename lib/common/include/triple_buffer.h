@@ -0,0 +1,50 @@
+#ifndef KUMA_ENGINE_LIB_COMMON_TRIPLE_BUFFER_H_
+#define KUMA_ENGINE_LIB_COMMON_TRIPLE_BUFFER_H_
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+namespace common
+{
+    //Hands values from one writer thread to one reader thread without either of them waiting
+    //The writer fills its buffer and publishes it, the reader takes the latest published buffer,
+    //the third buffer sits between them so neither ever touches the buffer the other is using
+    //The buffers are reused, so values holding containers keep their capacity from one publish to the next
+    template <typename T>
+    class TripleBuffer
+    {
+    private:
+        static constexpr std::uint8_t kIndexMask = 0x3;
+        static constexpr std::uint8_t kFreshBit = 0x4; //Set when the middle buffer was published after the last read
+
+        std::array<T, 3> buffers_{};
+        std::atomic<std::uint8_t> middle_{1};
+        std::uint8_t write_index_ = 0;
+        std::uint8_t read_index_ = 2;
+
+    public:
+        //Writer side
+        [[nodiscard]] T& write_buffer() { return buffers_[write_index_]; }
+
+        void Publish()
+        {
+            write_index_ = middle_.exchange(write_index_ | kFreshBit, std::memory_order_acq_rel) & kIndexMask;
+        }
+
+        //Reader side, returns false and keeps the current buffer when nothing was published since the last call
+        bool Acquire()
+        {
+            if (!(middle_.load(std::memory_order_relaxed) & kFreshBit))
+            {
+                return false;
+            }
+            read_index_ = middle_.exchange(read_index_, std::memory_order_acq_rel) & kIndexMask;
+            return true;
+        }
+
+        [[nodiscard]] const T& read_buffer() const { return buffers_[read_index_]; }
+    };
+}
+
+#endif //KUMA_ENGINE_LIB_COMMON_TRIPLE_BUFFER_H_
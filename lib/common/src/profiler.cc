@@ -0,0 +1,44 @@
+#include "profiler.h"
+
+#ifdef TRACE_ENABLE
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace
+{
+    std::atomic<std::int64_t> allocation_count{0};
+}
+
+std::int64_t common::TakeAllocationCount()
+{
+    return allocation_count.exchange(0, std::memory_order_relaxed);
+}
+
+//Every heap allocation is counted and shown in the Tracy memory view
+void* operator new(const std::size_t size)
+{
+    void* pointer = std::malloc(size == 0 ? 1 : size);
+    if (pointer == nullptr)
+    {
+        throw std::bad_alloc();
+    }
+    allocation_count.fetch_add(1, std::memory_order_relaxed);
+    TracyAlloc(pointer, size);
+    return pointer;
+}
+
+void operator delete(void* pointer) noexcept
+{
+    TracyFree(pointer);
+    std::free(pointer);
+}
+
+void operator delete(void* pointer, std::size_t) noexcept
+{
+    TracyFree(pointer);
+    std::free(pointer);
+}
+
+#endif
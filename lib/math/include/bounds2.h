@@ -0,0 +1,69 @@
+#ifndef KUMA_ENGINE_LIB_MATH_BOUNDS2_H_
+#define KUMA_ENGINE_LIB_MATH_BOUNDS2_H_
+
+#include <algorithm>
+
+#include "vec2.h"
+
+namespace math
+{
+    //Axis aligned bounds stored as their two corners only, for the broad phase and the quadtree
+    //The centre and the size are computed when asked, nothing needs a square root
+    template <typename T>
+    class Bounds2
+    {
+    private:
+        Vec2<T> min_bound_ = Vec2<T>::Zero();
+        Vec2<T> max_bound_ = Vec2<T>::Zero();
+
+    public:
+        constexpr Bounds2() = default;
+
+        constexpr Bounds2(const Vec2<T> min_bound, const Vec2<T> max_bound) : min_bound_(min_bound), max_bound_(max_bound)
+        {
+        }
+
+        [[nodiscard]] constexpr Vec2<T> min_bound() const { return min_bound_; }
+        [[nodiscard]] constexpr Vec2<T> max_bound() const { return max_bound_; }
+
+        [[nodiscard]] constexpr Vec2<T> Centre() const { return (min_bound_ + max_bound_) * static_cast<T>(0.5); }
+        [[nodiscard]] constexpr Vec2<T> HalfSize() const { return (max_bound_ - min_bound_) * static_cast<T>(0.5); }
+
+        [[nodiscard]] constexpr bool Contains(const Vec2<T> point) const
+        {
+            return point.x >= min_bound_.x && point.x <= max_bound_.x &&
+                   point.y >= min_bound_.y && point.y <= max_bound_.y;
+        }
+
+        [[nodiscard]] constexpr bool Contains(const Bounds2& other) const
+        {
+            return Contains(other.min_bound_) && Contains(other.max_bound_);
+        }
+
+        //Bounds covering these bounds and the same bounds moved by offset
+        [[nodiscard]] constexpr Bounds2 Swept(const Vec2<T> offset) const
+        {
+            const Vec2<T> end_min = min_bound_ + offset;
+            const Vec2<T> end_max = max_bound_ + offset;
+            return {Vec2<T>(std::min(min_bound_.x, end_min.x), std::min(min_bound_.y, end_min.y)),
+                    Vec2<T>(std::max(max_bound_.x, end_max.x), std::max(max_bound_.y, end_max.y))};
+        }
+
+        constexpr bool operator==(const Bounds2& other) const
+        {
+            return min_bound_ == other.min_bound_ && max_bound_ == other.max_bound_;
+        }
+    };
+
+    template <typename T>
+    [[nodiscard]] constexpr bool Intersect(const Bounds2<T>& bounds_a, const Bounds2<T>& bounds_b)
+    {
+        if (bounds_a.max_bound().x < bounds_b.min_bound().x || bounds_a.min_bound().x > bounds_b.max_bound().x) return false;
+        if (bounds_a.max_bound().y < bounds_b.min_bound().y || bounds_a.min_bound().y > bounds_b.max_bound().y) return false;
+        return true;
+    }
+
+    using Bounds2f = Bounds2<float>;
+}
+
+#endif //KUMA_ENGINE_LIB_MATH_BOUNDS2_H_
@@ -0,0 +1,25 @@
+﻿#ifndef KUMA_ENGINE_LIB_MATH_FOUR_INTERSECT_H_
+#define KUMA_ENGINE_LIB_MATH_FOUR_INTERSECT_H_
+
+#include <array>
+
+#include "four_vec2.h"
+
+namespace math
+{
+    //Overlap tests of four shape pairs at once, with SIMD intrinsics
+    //Bit i of the result is set when pair i overlaps, with the same rules as the scalar Intersect functions
+
+    //Circles touching exactly do not overlap
+    [[nodiscard]] int IntersectFourCircles(const FourVec2f& centres_a, const std::array<float, 4>& radii_a,
+                                           const FourVec2f& centres_b, const std::array<float, 4>& radii_b);
+
+    //Boxes given by their corners, boxes touching on an edge overlap
+    [[nodiscard]] int IntersectFourAABBs(const FourVec2f& min_a, const FourVec2f& max_a,
+                                         const FourVec2f& min_b, const FourVec2f& max_b);
+
+    [[nodiscard]] int IntersectFourAABBCircles(const FourVec2f& min, const FourVec2f& max,
+                                               const FourVec2f& centres, const std::array<float, 4>& radii);
+}
+
+#endif //KUMA_ENGINE_LIB_MATH_FOUR_INTERSECT_H_
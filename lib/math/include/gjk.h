@@ -0,0 +1,233 @@
+#ifndef KUMA_ENGINE_LIB_MATH_GJK_H_
+#define KUMA_ENGINE_LIB_MATH_GJK_H_
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <utility>
+
+#include "vec2.h"
+
+namespace math
+{
+    static constexpr int kMaxGjkIterations = 32;
+    static constexpr int kMaxEpaIterations = 32;
+    static constexpr int kMaxEpaVertices = kMaxEpaIterations + 3;
+    static constexpr float kGjkTolerance = 1e-4f;
+    static constexpr float kEpaTolerance = 1e-3f;
+
+    //Points of the Minkowski difference A - B kept by GJK, at most a triangle in 2D
+    struct Simplex
+    {
+        std::array<Vec2f, 3> points{};
+        int count = 0;
+    };
+
+    //Overlap of two shapes, moving A by normal * depth separates them
+    //The normal points from B to A, like the contact normals of the solver
+    struct Penetration
+    {
+        Vec2f normal = Vec2f::Zero();
+        float depth = 0.0f;
+    };
+
+    //The support functions are callables returning the furthest point of a shape in a direction,
+    //so GJK and EPA work on any convex shape without building vertex lists
+    template <typename SupportA, typename SupportB>
+    [[nodiscard]] constexpr Vec2f MinkowskiSupport(const SupportA& support_a, const SupportB& support_b, const Vec2f direction)
+    {
+        return support_a(direction) - support_b(-direction);
+    }
+
+    //Closest point to the origin on the simplex, the simplex is reduced to the feature holding it
+    //Returns zero when the origin is inside the triangle
+    [[nodiscard]] constexpr Vec2f ClosestPointToOrigin(Simplex& simplex)
+    {
+        //Closest point on the segment [a, b], keeps only the end point when it is the closest
+        const auto closest_on_segment = [](const Vec2f a, const Vec2f b, float& t)
+        {
+            const Vec2f ab = b - a;
+            const float length_squared = ab.SquareMagnitude();
+            t = length_squared > std::numeric_limits<float>::epsilon() ? std::clamp(-a.Dot(ab) / length_squared, 0.0f, 1.0f) : 0.0f;
+            return a + ab * t;
+        };
+
+        auto& points = simplex.points;
+        if (simplex.count == 1) { return points[0]; }
+
+        if (simplex.count == 2)
+        {
+            float t = 0.0f;
+            const Vec2f closest = closest_on_segment(points[0], points[1], t);
+            if (t <= 0.0f)
+            {
+                simplex.count = 1;
+            }
+            else if (t >= 1.0f)
+            {
+                points[0] = points[1];
+                simplex.count = 1;
+            }
+            return closest;
+        }
+
+        const Vec2f a = points[0];
+        const Vec2f b = points[1];
+        const Vec2f c = points[2];
+
+        //The origin is inside when it lies on the same side of the three edges
+        const float area = Vec2f::Cross(b - a, c - a);
+        if (std::abs(area) > std::numeric_limits<float>::epsilon())
+        {
+            const float side_ab = Vec2f::Cross(b - a, -a) * area;
+            const float side_bc = Vec2f::Cross(c - b, -b) * area;
+            const float side_ca = Vec2f::Cross(a - c, -c) * area;
+            if (side_ab >= 0.0f && side_bc >= 0.0f && side_ca >= 0.0f) { return Vec2f::Zero(); }
+        }
+
+        //Otherwise keep the edge closest to the origin
+        const std::array<std::pair<Vec2f, Vec2f>, 3> edges = {{{a, b}, {b, c}, {c, a}}};
+        Vec2f best = Vec2f::Zero();
+        float best_distance = std::numeric_limits<float>::max();
+        size_t best_edge = 0;
+        for (size_t i = 0; i < edges.size(); ++i)
+        {
+            float t = 0.0f;
+            const Vec2f closest = closest_on_segment(edges[i].first, edges[i].second, t);
+            if (closest.SquareMagnitude() < best_distance)
+            {
+                best = closest;
+                best_distance = closest.SquareMagnitude();
+                best_edge = i;
+            }
+        }
+        points[0] = edges[best_edge].first;
+        points[1] = edges[best_edge].second;
+        simplex.count = 2;
+        return best;
+    }
+
+    //GJK boolean query, stops as soon as a separating axis is found
+    //When the shapes overlap, the simplex is left around the origin for EPA
+    template <typename SupportA, typename SupportB>
+    [[nodiscard]] constexpr bool GjkIntersect(const SupportA& support_a, const SupportB& support_b, Simplex& simplex)
+    {
+        simplex.points[0] = MinkowskiSupport(support_a, support_b, Vec2f(1.0f, 0.0f));
+        simplex.count = 1;
+        Vec2f closest = simplex.points[0];
+
+        for (int i = 0; i < kMaxGjkIterations; ++i)
+        {
+            if (closest.SquareMagnitude() <= kGjkTolerance * kGjkTolerance) { return true; }
+
+            const Vec2f point = MinkowskiSupport(support_a, support_b, -closest);
+            if (point.Dot(closest) > 0.0f) { return false; }
+
+            simplex.points[simplex.count++] = point;
+            closest = ClosestPointToOrigin(simplex);
+        }
+        return true;
+    }
+
+    //GJK distance query, returns zero when the shapes overlap
+    //closest_point is the point of A - B closest to the origin, it points from B to A
+    template <typename SupportA, typename SupportB>
+    [[nodiscard]] constexpr float GjkDistance(const SupportA& support_a, const SupportB& support_b,
+                                              Simplex& simplex, Vec2f& closest_point)
+    {
+        simplex.points[0] = MinkowskiSupport(support_a, support_b, Vec2f(1.0f, 0.0f));
+        simplex.count = 1;
+        Vec2f closest = simplex.points[0];
+
+        for (int i = 0; i < kMaxGjkIterations; ++i)
+        {
+            const float distance_squared = closest.SquareMagnitude();
+            if (distance_squared <= kGjkTolerance * kGjkTolerance)
+            {
+                closest_point = Vec2f::Zero();
+                return 0.0f;
+            }
+
+            //Stop once the support point brings the simplex no closer to the origin
+            const Vec2f point = MinkowskiSupport(support_a, support_b, -closest);
+            if (distance_squared - point.Dot(closest) <= kGjkTolerance * distance_squared) { break; }
+
+            simplex.points[simplex.count++] = point;
+            closest = ClosestPointToOrigin(simplex);
+        }
+
+        closest_point = closest;
+        return closest.Magnitude();
+    }
+
+    //Expanding polytope algorithm, grows the simplex left by GJK until it reaches the edge of A - B closest to the origin
+    template <typename SupportA, typename SupportB>
+    [[nodiscard]] constexpr Penetration Epa(const SupportA& support_a, const SupportB& support_b, const Simplex& simplex)
+    {
+        constexpr float epsilon = std::numeric_limits<float>::epsilon();
+
+        std::array<Vec2f, kMaxEpaVertices> polytope{};
+        int count = simplex.count;
+        for (int i = 0; i < count; ++i) { polytope[i] = simplex.points[i]; }
+
+        //Shapes that only touch leave a point or a segment, grow it into a triangle
+        if (count == 1)
+        {
+            polytope[count++] = MinkowskiSupport(support_a, support_b, Vec2f(1.0f, 0.0f));
+            if ((polytope[1] - polytope[0]).SquareMagnitude() <= epsilon)
+            {
+                polytope[1] = MinkowskiSupport(support_a, support_b, Vec2f(-1.0f, 0.0f));
+            }
+        }
+        if (count == 2)
+        {
+            const Vec2f edge = polytope[1] - polytope[0];
+            polytope[count] = MinkowskiSupport(support_a, support_b, edge.Perpendicular());
+            if (std::abs(Vec2f::Cross(edge, polytope[count] - polytope[0])) <= epsilon)
+            {
+                polytope[count] = MinkowskiSupport(support_a, support_b, edge.Perpendicular2());
+            }
+            ++count;
+        }
+
+        //Counter-clockwise winding, so the outward normal of an edge is its second perpendicular
+        const float area = Vec2f::Cross(polytope[1] - polytope[0], polytope[2] - polytope[0]);
+        if (std::abs(area) <= epsilon) { return {}; }
+        if (area < 0.0f) { std::swap(polytope[1], polytope[2]); }
+
+        Penetration penetration;
+        for (int iteration = 0; iteration < kMaxEpaIterations; ++iteration)
+        {
+            int closest_edge = 0;
+            float closest_distance = std::numeric_limits<float>::max();
+            Vec2f closest_normal = Vec2f::Zero();
+            for (int i = 0; i < count; ++i)
+            {
+                const Vec2f edge = polytope[(i + 1) % count] - polytope[i];
+                const Vec2f normal = edge.Perpendicular2().Normalized();
+                const float distance = normal.Dot(polytope[i]);
+                if (distance < closest_distance)
+                {
+                    closest_edge = i;
+                    closest_distance = distance;
+                    closest_normal = normal;
+                }
+            }
+
+            //A moves against the outward normal of A - B to leave B
+            penetration = {-closest_normal, closest_distance};
+
+            const Vec2f point = MinkowskiSupport(support_a, support_b, closest_normal);
+            if (point.Dot(closest_normal) - closest_distance <= kEpaTolerance || count == kMaxEpaVertices) { break; }
+
+            //Insert the new point between the two vertices of the closest edge
+            for (int i = count; i > closest_edge + 1; --i) { polytope[i] = polytope[i - 1]; }
+            polytope[closest_edge + 1] = point;
+            ++count;
+        }
+        return penetration;
+    }
+}
+
+#endif //KUMA_ENGINE_LIB_MATH_GJK_H_
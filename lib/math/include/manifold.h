@@ -0,0 +1,248 @@
+#ifndef KUMA_ENGINE_LIB_MATH_MANIFOLD_H_
+#define KUMA_ENGINE_LIB_MATH_MANIFOLD_H_
+
+#include <array>
+#include <cmath>
+#include <limits>
+
+#include "shape.h"
+#include "vec2.h"
+
+namespace math
+{
+    //Faces whose separations differ by less than this are treated as equally good reference faces
+    static constexpr float kReferenceFaceTolerance = 0.1f;
+    //Fraction of the penetration a cached reference face may drift by before the faces are searched again
+    static constexpr float kRelativeFaceTolerance = 0.02f;
+    static constexpr float kCachedAxisAlignment = 0.999f;
+
+    //Axis kept for a polygon pair between steps
+    //It is the last separating axis while the pair is apart and the last reference face normal while it touches
+    //Stored as a direction so it does not depend on the order of the pair
+    struct SatCache
+    {
+        Vec2f axis = Vec2f::Zero();
+        //Reference face found by the last full search of a touching pair, on the polygon whose face normal is the axis
+        size_t edge = 0;
+        float separation = 0.0f;
+        bool touching = false;
+    };
+
+    //Deepest face of each polygon, found by the overlap test and reused by the manifold of the same pair
+    struct SatQuery
+    {
+        size_t edge_a = 0;
+        size_t edge_b = 0;
+        float separation_a = std::numeric_limits<float>::lowest();
+        float separation_b = std::numeric_limits<float>::lowest();
+        bool cached_face = false; //Only the cached reference face was tested, the other polygon has no face
+    };
+
+    //Contact points between two polygons, the normal points from B to A
+    struct Manifold
+    {
+        Vec2f normal = Vec2f::Zero();
+        std::array<Vec2f, 2> points{};
+        std::array<float, 2> penetrations{};
+        int point_count = 0;
+    };
+
+    //Gap between the projections of both polygons on an axis, positive when the axis separates them
+    [[nodiscard]] constexpr float AxisSeparation(const Polygon& polygon_a, const Polygon& polygon_b, const Vec2f axis)
+    {
+        const float gap_ab = polygon_b.Support(-axis).Dot(axis) - polygon_a.Support(axis).Dot(axis);
+        const float gap_ba = polygon_a.Support(-axis).Dot(axis) - polygon_b.Support(axis).Dot(axis);
+        return std::max(gap_ab, gap_ba);
+    }
+
+    //Separation of polygon_b from the face edge of polygon_a
+    [[nodiscard]] constexpr float FaceSeparation(const Polygon& polygon_a, const Polygon& polygon_b, const size_t edge)
+    {
+        const Vec2f normal = polygon_a.Normal(edge);
+        return normal.Dot(polygon_b.Support(-normal) - polygon_a.Vertex(edge));
+    }
+
+    //Edge of polygon_a with the largest separation from polygon_b
+    [[nodiscard]] constexpr float FindMaxSeparation(const Polygon& polygon_a, const Polygon& polygon_b, size_t& edge)
+    {
+        float max_separation = std::numeric_limits<float>::lowest();
+        for (size_t i = 0; i < polygon_a.VertexCount(); ++i)
+        {
+            const float separation = FaceSeparation(polygon_a, polygon_b, i);
+            if (separation > max_separation)
+            {
+                max_separation = separation;
+                edge = i;
+            }
+        }
+        return max_separation;
+    }
+
+    //Keeps the part of a segment behind the plane dot(normal, p) = offset, returns the number of points kept
+    constexpr int ClipSegment(std::array<Vec2f, 2>& segment, const Vec2f normal, const float offset)
+    {
+        const float distance_0 = normal.Dot(segment[0]) - offset;
+        const float distance_1 = normal.Dot(segment[1]) - offset;
+
+        std::array<Vec2f, 2> clipped{};
+        int count = 0;
+        if (distance_0 <= 0.0f) { clipped[count++] = segment[0]; }
+        if (distance_1 <= 0.0f) { clipped[count++] = segment[1]; }
+        if (distance_0 * distance_1 < 0.0f)
+        {
+            clipped[count++] = segment[0] + (segment[1] - segment[0]) * (distance_0 / (distance_0 - distance_1));
+        }
+
+        segment = clipped;
+        return count;
+    }
+
+    //Tries the reference face cached by a touching pair, fills the query with it while its separation stays within
+    //the tolerances of the one it had at the last full search, as long as it has not turned by more than the alignment
+    //The polygon it belongs to is found back from the axis, so it does not depend on the order of the pair
+    //When both polygons have a face along the axis, the cached one faces the other polygon and separates it the most
+    [[nodiscard]] constexpr bool TryCachedFace(const Polygon& polygon_a, const Polygon& polygon_b, SatCache& cache, SatQuery& query)
+    {
+        const auto is_cached_face = [&cache](const Polygon& polygon)
+        {
+            return cache.edge < polygon.VertexCount() && polygon.Normal(cache.edge).Dot(cache.axis) > kCachedAxisAlignment;
+        };
+        constexpr float kNoFace = std::numeric_limits<float>::lowest();
+        const float separation_a = is_cached_face(polygon_a) ? FaceSeparation(polygon_a, polygon_b, cache.edge) : kNoFace;
+        const float separation_b = is_cached_face(polygon_b) ? FaceSeparation(polygon_b, polygon_a, cache.edge) : kNoFace;
+        const bool on_a = separation_a >= separation_b;
+        const float separation = on_a ? separation_a : separation_b;
+
+        const float tolerance = kRelativeFaceTolerance * std::abs(cache.separation) + kReferenceFaceTolerance;
+        if (separation == kNoFace || separation > 0.0f || std::abs(separation - cache.separation) > tolerance) { return false; }
+
+        query = {};
+        query.cached_face = true;
+        (on_a ? query.edge_a : query.edge_b) = cache.edge;
+        (on_a ? query.separation_a : query.separation_b) = separation;
+        return true;
+    }
+
+    //SAT test that tries the cached axis or face before the edge normals, fills the query when the polygons overlap
+    [[nodiscard]] constexpr bool Intersect(const Polygon& polygon_a, const Polygon& polygon_b, SatCache& cache, SatQuery& query)
+    {
+        if (cache.touching)
+        {
+            if (TryCachedFace(polygon_a, polygon_b, cache, query)) { return true; }
+        }
+        else if (cache.axis != Vec2f::Zero() && AxisSeparation(polygon_a, polygon_b, cache.axis) > 0.0f)
+        {
+            return false;
+        }
+
+        query = {};
+        query.separation_a = FindMaxSeparation(polygon_a, polygon_b, query.edge_a);
+        if (query.separation_a > 0.0f)
+        {
+            cache.axis = polygon_a.Normal(query.edge_a);
+            cache.touching = false;
+            return false;
+        }
+
+        query.separation_b = FindMaxSeparation(polygon_b, polygon_a, query.edge_b);
+        if (query.separation_b > 0.0f)
+        {
+            cache.axis = polygon_b.Normal(query.edge_b);
+            cache.touching = false;
+            return false;
+        }
+        return true;
+    }
+
+    [[nodiscard]] constexpr bool Intersect(const Polygon& polygon_a, const Polygon& polygon_b, SatCache& cache)
+    {
+        SatQuery query;
+        return Intersect(polygon_a, polygon_b, cache, query);
+    }
+
+    //Contact manifold of two overlapping convex polygons, from the query of their Intersect test
+    //The incident edge is clipped against the reference face
+    [[nodiscard]] constexpr Manifold CollidePolygons(const Polygon& polygon_a, const Polygon& polygon_b, SatCache& cache,
+                                                     const SatQuery& query)
+    {
+        const size_t edge_a = query.edge_a;
+        const size_t edge_b = query.edge_b;
+        const float separation_a = query.separation_a;
+        const float separation_b = query.separation_b;
+
+        //The face with the smallest penetration is the reference, the last one is kept while it stays about as good
+        bool reference_is_b = separation_b > separation_a + kReferenceFaceTolerance;
+        if (cache.axis != Vec2f::Zero())
+        {
+            if (cache.axis.Dot(polygon_a.Normal(edge_a)) > kCachedAxisAlignment &&
+                separation_a + kReferenceFaceTolerance >= separation_b)
+            {
+                reference_is_b = false;
+            }
+            else if (cache.axis.Dot(polygon_b.Normal(edge_b)) > kCachedAxisAlignment &&
+                     separation_b + kReferenceFaceTolerance >= separation_a)
+            {
+                reference_is_b = true;
+            }
+        }
+
+        const Polygon& reference = reference_is_b ? polygon_b : polygon_a;
+        const Polygon& incident = reference_is_b ? polygon_a : polygon_b;
+        const size_t reference_edge = reference_is_b ? edge_b : edge_a;
+        const Vec2f reference_normal = reference.Normal(reference_edge);
+        //The cache keeps the face of the last full search, so a cached face cannot drift away from it step after step
+        if (!query.cached_face)
+        {
+            cache.axis = reference_normal;
+            cache.edge = reference_edge;
+            cache.separation = reference_is_b ? separation_b : separation_a;
+            cache.touching = true;
+        }
+
+        //Incident edge, the one facing the reference face the most
+        size_t incident_edge = 0;
+        float min_dot = std::numeric_limits<float>::max();
+        for (size_t i = 0; i < incident.VertexCount(); ++i)
+        {
+            if (const float dot = reference_normal.Dot(incident.Normal(i)); dot < min_dot)
+            {
+                min_dot = dot;
+                incident_edge = i;
+            }
+        }
+
+        std::array<Vec2f, 2> segment = {
+            incident.Vertex(incident_edge), incident.Vertex((incident_edge + 1) % incident.VertexCount())};
+
+        //Clip the incident edge to the side planes of the reference face
+        const Vec2f face_start = reference.Vertex(reference_edge);
+        const Vec2f face_end = reference.Vertex((reference_edge + 1) % reference.VertexCount());
+        const Vec2f tangent = (face_end - face_start).Normalized();
+        if (ClipSegment(segment, -tangent, -tangent.Dot(face_start)) < 2) { return {}; }
+        if (ClipSegment(segment, tangent, tangent.Dot(face_end)) < 2) { return {}; }
+
+        Manifold manifold;
+        manifold.normal = reference_is_b ? reference_normal : -reference_normal;
+        for (const auto& point : segment)
+        {
+            const float separation = reference_normal.Dot(point - face_start);
+            if (separation > 0.0f) { continue; }
+
+            //Halfway between the incident point and the reference face
+            manifold.points[manifold.point_count] = point - reference_normal * (separation * 0.5f);
+            manifold.penetrations[manifold.point_count] = -separation;
+            ++manifold.point_count;
+        }
+        return manifold;
+    }
+
+    //Contact manifold of two convex polygons, empty when they do not overlap
+    [[nodiscard]] constexpr Manifold CollidePolygons(const Polygon& polygon_a, const Polygon& polygon_b, SatCache& cache)
+    {
+        SatQuery query;
+        if (!Intersect(polygon_a, polygon_b, cache, query)) { return {}; }
+        return CollidePolygons(polygon_a, polygon_b, cache, query);
+    }
+}
+
+#endif //KUMA_ENGINE_LIB_MATH_MANIFOLD_H_
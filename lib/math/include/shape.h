@@ -2,13 +2,22 @@
 #define KUMA_ENGINE_LIB_MATH_SHAPE_H_
 
 #include <algorithm>
-#include <vector>
-
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <initializer_list>
+#include <limits>
+#include <span>
+
+#include "bounds2.h"
+#include "gjk.h"
 #include "vec2.h"
 
 namespace math
 {
-    enum class ShapeType
+    //One byte, so it packs next to the other small members of a collider
+    enum class ShapeType : std::uint8_t
     {
         kAABB,
         kCircle,
@@ -16,67 +25,43 @@ namespace math
         kNone
     };
 
+    //Only the bounds are stored, the centre and half size are derived from them so the box stays 16 bytes
     class AABB
     {
     private:
         Vec2f min_bound_ = Vec2f::Zero();
         Vec2f max_bound_ = Vec2f::Zero();
-        Vec2f centre_ = Vec2f::Zero();
-        Vec2f half_size_vec_ = Vec2f::Zero();
-        float half_size_length_ = 0.0f;
 
     public:
         constexpr AABB(const Vec2f min_bound, const Vec2f max_bound) : min_bound_(min_bound), max_bound_(max_bound)
         {
-            centre_ = (min_bound + max_bound) * 0.5f;
-            half_size_vec_ = max_bound - centre_;
-            half_size_length_ = (max_bound - centre_).Magnitude();
         }
 
         constexpr AABB(const Vec2f min_bound,
                        const Vec2f max_bound,
-                       const Vec2f centre,
-                       const Vec2f half_size_vec,
-                       const float half_size_length) :
+                       [[maybe_unused]] const Vec2f centre,
+                       [[maybe_unused]] const Vec2f half_size_vec,
+                       [[maybe_unused]] const float half_size_length) :
             min_bound_(min_bound),
-            max_bound_(max_bound),
-            centre_(centre),
-            half_size_vec_(half_size_vec),
-            half_size_length_(half_size_length)
+            max_bound_(max_bound)
         {
         }
 
-        constexpr AABB(const Vec2f centre, const Vec2f half_size_vec, const float half_size_length)
+        constexpr AABB(const Vec2f centre, const Vec2f half_size_vec, [[maybe_unused]] const float half_size_length) :
+            min_bound_(centre - half_size_vec),
+            max_bound_(centre + half_size_vec)
         {
-            half_size_vec_ = half_size_vec;
-            min_bound_ = Vec2f(centre - half_size_vec_);
-            max_bound_ = Vec2f(centre + half_size_vec_);
-            centre_ = centre;
-            half_size_length_ = half_size_length;;
         }
 
         AABB() = default;
 
         [[nodiscard]] constexpr Vec2f min_bound() const { return min_bound_; }
         [[nodiscard]] constexpr Vec2f max_bound() const { return max_bound_; }
-        [[nodiscard]] constexpr float half_size_length() const { return half_size_length_; }
-        [[nodiscard]] constexpr Vec2f half_size_vec() const { return half_size_vec_; }
-
-        void set_min_bound(const Vec2f bound)
-        {
-            min_bound_ = bound;
-            centre_ = (min_bound_ + max_bound_) * 0.5f;
-            half_size_vec_ = max_bound_ - centre_;
-            half_size_length_ = (max_bound_ - centre_).Magnitude();
-        }
+        [[nodiscard]] constexpr Vec2f half_size_vec() const { return (max_bound_ - min_bound_) * 0.5f; }
+        [[nodiscard]] constexpr float half_size_length() const { return half_size_vec().Magnitude(); }
 
-        void set_max_bound(const Vec2f bound)
-        {
-            max_bound_ = bound;
-            centre_ = (min_bound_ + max_bound_) * 0.5f;
-            half_size_vec_ = max_bound_ - centre_;
-            half_size_length_ = (max_bound_ - centre_).Magnitude();
-        }
+        void set_min_bound(const Vec2f bound) { min_bound_ = bound; }
+        void set_max_bound(const Vec2f bound) { max_bound_ = bound; }
 
         [[nodiscard]] constexpr bool Contains(const Vec2f point) const
         {
@@ -92,14 +77,29 @@ namespace math
             return *this;
         }
 
+        [[nodiscard]] constexpr Bounds2f GetBounds() const { return {min_bound_, max_bound_}; }
+
         [[nodiscard]] Vec2f GetCentre() const { return (min_bound_ + max_bound_) * 0.5f; }
         [[nodiscard]] static constexpr ShapeType GetShapeType() { return ShapeType::kAABB; }
 
+        //Furthest corner in a direction
+        [[nodiscard]] constexpr Vec2f Support(const Vec2f direction) const
+        {
+            return {direction.x >= 0.0f ? max_bound_.x : min_bound_.x, direction.y >= 0.0f ? max_bound_.y : min_bound_.y};
+        }
+
+        //Moment of inertia of the box around its centre, treated as an oriented box of the same size
+        [[nodiscard]] constexpr float CalculateInertia(const float mass) const
+        {
+            const Vec2f size = max_bound_ - min_bound_;
+            return mass * (size.x * size.x + size.y * size.y) / 12.0f;
+        }
+
         void UpdatePosition(const Vec2f position)
         {
-            centre_ = position;
-            min_bound_ = Vec2f(centre_ - half_size_vec_);
-            max_bound_ = Vec2f(centre_ + half_size_vec_);
+            const Vec2f half_size = half_size_vec();
+            min_bound_ = position - half_size;
+            max_bound_ = position + half_size;
         }
 
         bool operator==(const AABB& other) const
@@ -142,8 +142,27 @@ namespace math
             return box;
         }
 
+        [[nodiscard]] constexpr Bounds2f GetBounds() const
+        {
+            return {centre_ - Vec2f(radius_, radius_), centre_ + Vec2f(radius_, radius_)};
+        }
+
         [[nodiscard]] static constexpr ShapeType GetShapeType() { return ShapeType::kCircle; }
 
+        //Furthest point of the circle in a direction
+        [[nodiscard]] constexpr Vec2f Support(const Vec2f direction) const
+        {
+            const float length = direction.Magnitude();
+            if (length == 0.0f) { return centre_; }
+            return centre_ + direction * (radius_ / length);
+        }
+
+        //Moment of inertia of a solid disc around its centre
+        [[nodiscard]] constexpr float CalculateInertia(const float mass) const
+        {
+            return 0.5f * mass * radius_ * radius_;
+        }
+
         void UpdatePosition(const Vec2f position)
         {
             centre_ = position;
@@ -155,51 +174,291 @@ namespace math
         }
     };
 
+    static constexpr std::size_t kMaxPolygonVertices = 8;
+
+    //World space vertices or normals of a polygon, computed on demand into a stack array
+    struct PolygonPoints
+    {
+        std::array<Vec2f, kMaxPolygonVertices> points{};
+        std::size_t count = 0;
+
+        [[nodiscard]] constexpr Vec2f operator[](const std::size_t i) const { return points[i]; }
+        [[nodiscard]] constexpr std::size_t size() const { return count; }
+        [[nodiscard]] constexpr bool empty() const { return count == 0; }
+        [[nodiscard]] constexpr const Vec2f* begin() const { return points.data(); }
+        [[nodiscard]] constexpr const Vec2f* end() const { return points.data() + count; }
+        constexpr operator std::span<const Vec2f>() const { return {points.data(), count}; }
+    };
+
+    //Convex polygon of at most kMaxPolygonVertices vertices, stored inline so copies never allocate
     class Polygon
     {
     private:
-        std::vector<Vec2f> vertices_;
+        //Vertices and outward edge normals around the centroid, the normal at i belongs to the edge starting at vertex i
+        std::array<Vec2f, kMaxPolygonVertices> local_vertices_{};
+        std::array<Vec2f, kMaxPolygonVertices> local_normals_{};
+        std::uint32_t vertex_count_ = 0;
 
-    public:
-        explicit constexpr Polygon(const std::vector<Vec2f>& vertices) : vertices_(vertices)
+        Vec2f position_ = Vec2f::Zero(); //Centroid in world space
+        float rotation_ = 0.0f;
+        float cos_rotation_ = 1.0f;
+        float sin_rotation_ = 0.0f;
+
+        //Bounds of the rotated vertices around the position, rebuilt when the rotation changes
+        Vec2f local_min_bound_ = Vec2f::Zero();
+        Vec2f local_max_bound_ = Vec2f::Zero();
+
+        [[nodiscard]] constexpr Vec2f Rotate(const Vec2f v) const
         {
+            return {v.x * cos_rotation_ - v.y * sin_rotation_, v.x * sin_rotation_ + v.y * cos_rotation_};
         }
 
-        [[nodiscard]] constexpr std::vector<Vec2f> vertices() const { return vertices_; }
+        [[nodiscard]] constexpr Vec2f InverseRotate(const Vec2f v) const
+        {
+            return {v.x * cos_rotation_ + v.y * sin_rotation_, -v.x * sin_rotation_ + v.y * cos_rotation_};
+        }
 
-        void set_vertices(const std::vector<Vec2f>& vertices) { vertices_ = vertices; }
+        //Moves the vertices around their centroid and returns it
+        constexpr Vec2f SetLocalVertices(const std::span<const Vec2f> vertices)
+        {
+            assert(vertices.size() <= kMaxPolygonVertices && "Polygon has too many vertices");
+            const size_t count = std::min(vertices.size(), kMaxPolygonVertices);
 
-        [[nodiscard]] constexpr size_t VertexCount() const { return vertices_.size(); }
+            //Signed area, so the normals point outwards whatever the winding
+            float area = 0.0f;
+            Vec2f centroid = Vec2f::Zero();
+            for (size_t i = 0; i < count; ++i)
+            {
+                const Vec2f current = vertices[i];
+                const Vec2f next = vertices[(i + 1) % count];
+                const float cross = Vec2f::Cross(current, next);
+                area += cross;
+                centroid += (current + next) * cross;
+            }
 
-        [[nodiscard]] AABB GetBoundingBox() const
+            if (std::abs(area) > std::numeric_limits<float>::epsilon())
+            {
+                centroid = centroid / (3.0f * area);
+            }
+            else
+            {
+                //Degenerate polygon, fall back to the average of the vertices
+                centroid = Vec2f::Zero();
+                for (size_t i = 0; i < count; ++i) { centroid += vertices[i]; }
+                centroid = centroid / static_cast<float>(std::max<size_t>(count, 1));
+            }
+
+            vertex_count_ = static_cast<std::uint32_t>(count);
+            for (size_t i = 0; i < count; ++i)
+            {
+                local_vertices_[i] = vertices[i] - centroid;
+                const Vec2f edge = vertices[(i + 1) % count] - vertices[i];
+                local_normals_[i] = (area >= 0.0f ? edge.Perpendicular2() : edge.Perpendicular()).Normalized();
+            }
+            return centroid;
+        }
+
+        constexpr void UpdateLocalBounds()
         {
-            Vec2f min = vertices_[0];
-            Vec2f max = vertices_[0];
+            local_min_bound_ = Vec2f::Zero();
+            local_max_bound_ = Vec2f::Zero();
+            if (vertex_count_ == 0) { return; }
 
-            for (const auto& vertex : vertices_)
+            local_min_bound_ = Rotate(local_vertices_[0]);
+            local_max_bound_ = local_min_bound_;
+            for (const auto& vertex : local_vertices())
             {
-                min.x = std::min(min.x, vertex.x);
-                min.y = std::min(min.y, vertex.y);
-                max.x = std::max(max.x, vertex.x);
-                max.y = std::max(max.y, vertex.y);
+                const Vec2f rotated = Rotate(vertex);
+                local_min_bound_.x = std::min(local_min_bound_.x, rotated.x);
+                local_min_bound_.y = std::min(local_min_bound_.y, rotated.y);
+                local_max_bound_.x = std::max(local_max_bound_.x, rotated.x);
+                local_max_bound_.y = std::max(local_max_bound_.y, rotated.y);
             }
+        }
+
+        constexpr void UpdateRotation(const float rotation)
+        {
+            rotation_ = rotation;
+            cos_rotation_ = std::cos(rotation);
+            sin_rotation_ = std::sin(rotation);
+            UpdateLocalBounds();
+        }
+
+    public:
+        //Vertices given in world space, the polygon is placed at their centroid
+        explicit constexpr Polygon(const std::span<const Vec2f> vertices)
+        {
+            position_ = SetLocalVertices(vertices);
+            UpdateLocalBounds();
+        }
+
+        explicit constexpr Polygon(const std::initializer_list<Vec2f> vertices)
+            : Polygon(std::span<const Vec2f>(vertices.begin(), vertices.size()))
+        {
+        }
+
+        //Vertices given around a position, then rotated by rotation radians
+        constexpr Polygon(const std::span<const Vec2f> local_vertices, const Vec2f position, const float rotation)
+        {
+            const Vec2f centroid = SetLocalVertices(local_vertices);
+            UpdateRotation(rotation);
+            position_ = position + Rotate(centroid);
+        }
+
+        constexpr Polygon(const std::initializer_list<Vec2f> local_vertices, const Vec2f position, const float rotation)
+            : Polygon(std::span<const Vec2f>(local_vertices.begin(), local_vertices.size()), position, rotation)
+        {
+        }
+
+        //Polygon covering the same area as the box
+        [[nodiscard]] static constexpr Polygon FromAABB(const AABB& aabb)
+        {
+            return Polygon({
+                aabb.min_bound(), Vec2f(aabb.max_bound().x, aabb.min_bound().y),
+                aabb.max_bound(), Vec2f(aabb.min_bound().x, aabb.max_bound().y)});
+        }
+
+        [[nodiscard]] constexpr std::span<const Vec2f> local_vertices() const { return {local_vertices_.data(), vertex_count_}; }
+        [[nodiscard]] constexpr Vec2f position() const { return position_; }
+        [[nodiscard]] constexpr float rotation() const { return rotation_; }
+
+        //World space vertex and edge normal i, only the local ones are stored
+        [[nodiscard]] constexpr Vec2f Vertex(const size_t i) const { return position_ + Rotate(local_vertices_[i]); }
+        [[nodiscard]] constexpr Vec2f Normal(const size_t i) const { return Rotate(local_normals_[i]); }
+
+        //All the world space vertices or normals, transformed on each call
+        [[nodiscard]] constexpr PolygonPoints vertices() const
+        {
+            PolygonPoints points;
+            points.count = vertex_count_;
+            for (size_t i = 0; i < vertex_count_; ++i) { points.points[i] = Vertex(i); }
+            return points;
+        }
+
+        [[nodiscard]] constexpr PolygonPoints normals() const
+        {
+            PolygonPoints points;
+            points.count = vertex_count_;
+            for (size_t i = 0; i < vertex_count_; ++i) { points.points[i] = Normal(i); }
+            return points;
+        }
+
+        void set_vertices(const std::span<const Vec2f> vertices)
+        {
+            position_ = SetLocalVertices(vertices);
+            UpdateRotation(0.0f);
+        }
+
+        constexpr void set_rotation(const float rotation)
+        {
+            if (rotation == rotation_) { return; }
+
+            UpdateRotation(rotation);
+        }
+
+        //Moves and turns the polygon in one call, the bounds are only rebuilt when the rotation changed
+        constexpr void set_transform(const Vec2f position, const float rotation)
+        {
+            if (position == position_ && rotation == rotation_) { return; }
+
+            if (rotation != rotation_) { UpdateRotation(rotation); }
+            position_ = position;
+        }
+
+        //Furthest a vertex gets from the position, the most any point of the polygon moves per radian it turns
+        [[nodiscard]] constexpr float BoundingRadius() const
+        {
+            float radius = 0.0f;
+            for (const auto& vertex : local_vertices()) { radius = std::max(radius, vertex.Magnitude()); }
+            return radius;
+        }
+
+        [[nodiscard]] constexpr size_t VertexCount() const { return vertex_count_; }
+
+        //Cached bounds moved to the position, no vertex is visited
+        [[nodiscard]] AABB GetBoundingBox() const
+        {
+            return AABB(position_ + local_min_bound_, position_ + local_max_bound_);
+        }
 
-            return AABB(min, max);
+        [[nodiscard]] constexpr Bounds2f GetBounds() const
+        {
+            return {position_ + local_min_bound_, position_ + local_max_bound_};
         }
 
         [[nodiscard]] static constexpr ShapeType GetShapeType() { return ShapeType::kPolygon; }
 
-        void UpdatePosition(const Vec2f position)
+        //Furthest vertex in a direction, the direction is turned into the local frame so only the result is transformed
+        //A polygon without vertices supports like a point at its position
+        [[nodiscard]] constexpr Vec2f Support(const Vec2f direction) const
+        {
+            if (vertex_count_ == 0) { return position_; }
+
+            const Vec2f local_direction = InverseRotate(direction);
+            size_t best = 0;
+            float best_projection = local_vertices_[0].Dot(local_direction);
+            for (size_t i = 1; i < vertex_count_; ++i)
+            {
+                if (const float projection = local_vertices_[i].Dot(local_direction); projection > best_projection)
+                {
+                    best = i;
+                    best_projection = projection;
+                }
+            }
+            return Vertex(best);
+        }
+
+        //Moment of inertia of a solid convex polygon around its centroid
+        //The polygon is split in triangles fanning out from the first vertex
+        [[nodiscard]] constexpr float CalculateInertia(const float mass) const
+        {
+            if (vertex_count_ < 3) { return 0.0f; }
+
+            const Vec2f origin = local_vertices_[0];
+            float area = 0.0f;
+            float inertia = 0.0f;
+            Vec2f centroid = Vec2f::Zero();
+
+            for (size_t i = 1; i + 1 < vertex_count_; ++i)
+            {
+                const Vec2f e1 = local_vertices_[i] - origin;
+                const Vec2f e2 = local_vertices_[i + 1] - origin;
+                const float cross = Vec2f::Cross(e1, e2);
+                const float triangle_area = 0.5f * cross;
+
+                area += triangle_area;
+                centroid += (e1 + e2) * (triangle_area / 3.0f);
+                inertia += cross * (e1.Dot(e1) + e1.Dot(e2) + e2.Dot(e2)) / 12.0f;
+            }
+
+            if (area == 0.0f) { return 0.0f; }
+
+            //Inertia per unit of area around the first vertex, moved to the centroid (parallel axis theorem)
+            centroid = centroid / area;
+            const float density = mass / area;
+            return density * inertia - mass * centroid.SquareMagnitude();
+        }
+
+        //Moving keeps the rotated bounds
+        constexpr void UpdatePosition(const Vec2f position)
         {
-            return;
+            position_ = position;
         }
 
         bool operator==(const Polygon& other) const
         {
-            return vertices_ == other.vertices_;
+            return std::ranges::equal(local_vertices(), other.local_vertices()) &&
+                   position_ == other.position_ && rotation_ == other.rotation_;
         }
     };
 
+    //Support function of a shape, for GJK and EPA
+    template <typename Shape>
+    [[nodiscard]] constexpr auto SupportFunction(const Shape& shape)
+    {
+        return [&shape](const Vec2f direction) { return shape.Support(direction); };
+    }
+
     //Find the point of a segment that is closest to a specified point
     constexpr Vec2f ClosestPointOnSegment(const Vec2f segment_start, const Vec2f segment_end, const Vec2f compare_point)
     {
@@ -229,48 +488,8 @@ namespace math
 
     [[nodiscard]] constexpr bool Intersect(const Polygon& polygon_a, const Polygon& polygon_b)
     {
-        for (const auto polygons = {polygon_a, polygon_b}; const auto& polygon : polygons)
-        {
-            const auto& vertices = polygon.vertices();
-            const size_t vertex_count = polygon.VertexCount();
-
-            for (size_t i = 0; i < vertex_count; ++i)
-            {
-                //Compute the edge and perpendicular axis
-                Vec2f edge = vertices[(i + 1) % vertex_count] - vertices[i];
-                const Vec2f axis = edge.Perpendicular();
-
-                //Project all vertices of polygon_a onto the axis
-                float min_a = vertices[0].Dot(axis);
-                float max_a = min_a;
-                for (const auto& vertex : polygon_a.vertices())
-                {
-                    float projection = vertex.Dot(axis);
-                    min_a = std::min(min_a, projection);
-                    max_a = std::max(max_a, projection);
-                }
-
-                //Project all vertices of polygon_b onto the axis
-                float min_b = polygon_b.vertices()[0].Dot(axis);
-                float max_b = min_b;
-                for (const auto& vertex : polygon_b.vertices())
-                {
-                    float projection = vertex.Dot(axis);
-                    min_b = std::min(min_b, projection);
-                    max_b = std::max(max_b, projection);
-                }
-
-                //Check for an overlap on this axis
-                if (max_a < min_b || max_b < min_a)
-                {
-                    //No overlap on this axis means no intersection
-                    return false;
-                }
-            }
-        }
-
-        //If no separating axis was found, the polygons intersect
-        return true;
+        Simplex simplex;
+        return GjkIntersect(SupportFunction(polygon_a), SupportFunction(polygon_b), simplex);
     }
 
     [[nodiscard]] constexpr bool Intersect(const AABB& aabb, const Circle& circle)
@@ -289,39 +508,18 @@ namespace math
 
     [[nodiscard]] constexpr bool Intersect(const AABB& aabb, const Polygon& polygon)
     {
-        const std::vector<Vec2f> aabb_vertices = {
-            aabb.min_bound(),
-            Vec2f(aabb.min_bound().x, aabb.max_bound().y),
-            aabb.max_bound(),
-            Vec2f(aabb.max_bound().x, aabb.min_bound().y)
-        };
-        const Polygon aabb_polygon(aabb_vertices);
-        return Intersect(polygon, aabb_polygon);
+        Simplex simplex;
+        return GjkIntersect(SupportFunction(aabb), SupportFunction(polygon), simplex);
     }
 
+    //The circle is treated as its centre grown by the radius, so GJK only works on a point and the polygon
     [[nodiscard]] constexpr bool Intersect(const Circle& circle, const Polygon& polygon)
     {
-        const auto vertices = polygon.vertices();
-        const auto center = circle.centre();
-        auto radius = circle.radius();
-
-        //Check if any vertex of the polygon is inside the circle
-        for (const auto& vertex : vertices)
-        {
-            if (circle.Contains(vertex)) return true;
-        }
-
-        //Check if the circle intersects with any of the polygon's edges
-        for (size_t i = 0, j = polygon.VertexCount() - 1; i < polygon.VertexCount(); j = i++)
-        {
-            const Vec2f start = vertices[i];
-            const Vec2f end = vertices[j];
-
-            if (const Vec2f closest_point = ClosestPointOnSegment(start, end, center); circle.Contains(closest_point))
-                return true;
-        }
-        //If no intersection is found, return false
-        return false;
+        const Vec2f centre = circle.centre();
+        Simplex simplex;
+        Vec2f closest_point = Vec2f::Zero();
+        return GjkDistance([centre](Vec2f) { return centre; }, SupportFunction(polygon), simplex, closest_point)
+            <= circle.radius();
     }
 
     [[nodiscard]] constexpr bool Intersect(const Circle& circle, const AABB& aabb) { return Intersect(aabb, circle); }
@@ -335,6 +533,61 @@ namespace math
     {
         return Intersect(aabb, polygon);
     }
+
+    //Distances between the surfaces of two shapes, zero or negative when they overlap
+    [[nodiscard]] constexpr float Distance(const Circle& circle_a, const Circle& circle_b)
+    {
+        return (circle_a.centre() - circle_b.centre()).Magnitude() - circle_a.radius() - circle_b.radius();
+    }
+
+    [[nodiscard]] constexpr float Distance(const AABB& aabb, const Circle& circle)
+    {
+        const Vec2f centre = circle.centre();
+        const Vec2f closest_point(std::clamp(centre.x, aabb.min_bound().x, aabb.max_bound().x),
+                                  std::clamp(centre.y, aabb.min_bound().y, aabb.max_bound().y));
+        return (closest_point - centre).Magnitude() - circle.radius();
+    }
+
+    [[nodiscard]] constexpr float Distance(const Circle& circle, const AABB& aabb) { return Distance(aabb, circle); }
+
+    [[nodiscard]] constexpr float Distance(const AABB& aabb_a, const AABB& aabb_b)
+    {
+        const float gap_x = std::max(aabb_a.min_bound().x - aabb_b.max_bound().x, aabb_b.min_bound().x - aabb_a.max_bound().x);
+        const float gap_y = std::max(aabb_a.min_bound().y - aabb_b.max_bound().y, aabb_b.min_bound().y - aabb_a.max_bound().y);
+
+        //Overlapping on both axes, the shallowest overlap is the penetration
+        if (gap_x <= 0.0f && gap_y <= 0.0f) { return std::max(gap_x, gap_y); }
+
+        return Vec2f(std::max(gap_x, 0.0f), std::max(gap_y, 0.0f)).Magnitude();
+    }
+
+    //Polygon distances use GJK, they stop at zero when the shapes overlap
+    [[nodiscard]] constexpr float Distance(const Polygon& polygon_a, const Polygon& polygon_b)
+    {
+        Simplex simplex;
+        Vec2f closest_point = Vec2f::Zero();
+        return GjkDistance(SupportFunction(polygon_a), SupportFunction(polygon_b), simplex, closest_point);
+    }
+
+    [[nodiscard]] constexpr float Distance(const AABB& aabb, const Polygon& polygon)
+    {
+        Simplex simplex;
+        Vec2f closest_point = Vec2f::Zero();
+        return GjkDistance(SupportFunction(aabb), SupportFunction(polygon), simplex, closest_point);
+    }
+
+    [[nodiscard]] constexpr float Distance(const Polygon& polygon, const AABB& aabb) { return Distance(aabb, polygon); }
+
+    [[nodiscard]] constexpr float Distance(const Circle& circle, const Polygon& polygon)
+    {
+        const Vec2f centre = circle.centre();
+        Simplex simplex;
+        Vec2f closest_point = Vec2f::Zero();
+        return GjkDistance([centre](Vec2f) { return centre; }, SupportFunction(polygon), simplex, closest_point)
+            - circle.radius();
+    }
+
+    [[nodiscard]] constexpr float Distance(const Polygon& polygon, const Circle& circle) { return Distance(circle, polygon); }
 }
 
 #endif // KUMA_ENGINE_LIB_MATH_SHAPE_H_
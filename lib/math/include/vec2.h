@@ -100,7 +100,7 @@ namespace math
             throw std::out_of_range("Index out of range for Vec2");
         }
 
-        bool operator==(const Vec2& vec2) const
+        constexpr bool operator==(const Vec2& vec2) const
         {
             return x == vec2.x && y == vec2.y;
         };
@@ -116,6 +116,18 @@ namespace math
             return x * v.x + y * v.y;
         }
 
+        //2D cross product, the z component of the 3D cross product
+        static constexpr T Cross(Vec2 v1, Vec2 v2)
+        {
+            return v1.x * v2.y - v1.y * v2.x;
+        }
+
+        //Cross product of a scalar (angular velocity around z) with a vector
+        static constexpr Vec2 Cross(T s, Vec2 v)
+        {
+            return {-s * v.y, s * v.x};
+        }
+
         [[nodiscard]] constexpr T CrossProduct(const Vec2& v1, const Vec2& v2) const
         {
             return v1.x * v2.y - v1.y * v2.x;
@@ -0,0 +1,54 @@
+﻿#include "four_intersect.h"
+
+#include <limits>
+
+#include <xmmintrin.h>
+
+namespace math
+{
+    int IntersectFourCircles(const FourVec2f& centres_a, const std::array<float, 4>& radii_a,
+                             const FourVec2f& centres_b, const std::array<float, 4>& radii_b)
+    {
+        const __m128 dx = _mm_sub_ps(_mm_loadu_ps(centres_a.x.data()), _mm_loadu_ps(centres_b.x.data()));
+        const __m128 dy = _mm_sub_ps(_mm_loadu_ps(centres_a.y.data()), _mm_loadu_ps(centres_b.y.data()));
+        const __m128 radius_sum = _mm_add_ps(_mm_loadu_ps(radii_a.data()), _mm_loadu_ps(radii_b.data()));
+
+        //Squared distance between the centres against the squared sum of the radii
+        const __m128 distance_squared = _mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy));
+        const __m128 overlap = _mm_cmplt_ps(distance_squared, _mm_mul_ps(radius_sum, radius_sum));
+
+        return _mm_movemask_ps(overlap);
+    }
+
+    int IntersectFourAABBs(const FourVec2f& min_a, const FourVec2f& max_a,
+                           const FourVec2f& min_b, const FourVec2f& max_b)
+    {
+        //Overlap on both axes, max_a >= min_b and min_a <= max_b
+        const __m128 overlap_x = _mm_and_ps(_mm_cmpge_ps(_mm_loadu_ps(max_a.x.data()), _mm_loadu_ps(min_b.x.data())),
+                                            _mm_cmple_ps(_mm_loadu_ps(min_a.x.data()), _mm_loadu_ps(max_b.x.data())));
+        const __m128 overlap_y = _mm_and_ps(_mm_cmpge_ps(_mm_loadu_ps(max_a.y.data()), _mm_loadu_ps(min_b.y.data())),
+                                            _mm_cmple_ps(_mm_loadu_ps(min_a.y.data()), _mm_loadu_ps(max_b.y.data())));
+
+        return _mm_movemask_ps(_mm_and_ps(overlap_x, overlap_y));
+    }
+
+    int IntersectFourAABBCircles(const FourVec2f& min, const FourVec2f& max,
+                                 const FourVec2f& centres, const std::array<float, 4>& radii)
+    {
+        const __m128 centre_x = _mm_loadu_ps(centres.x.data());
+        const __m128 centre_y = _mm_loadu_ps(centres.y.data());
+
+        //Clamp the centres to the boxes to find their closest points
+        const __m128 closest_x = _mm_min_ps(_mm_max_ps(centre_x, _mm_loadu_ps(min.x.data())), _mm_loadu_ps(max.x.data()));
+        const __m128 closest_y = _mm_min_ps(_mm_max_ps(centre_y, _mm_loadu_ps(min.y.data())), _mm_loadu_ps(max.y.data()));
+
+        const __m128 dx = _mm_sub_ps(closest_x, centre_x);
+        const __m128 dy = _mm_sub_ps(closest_y, centre_y);
+        const __m128 distance_squared = _mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy));
+
+        const __m128 radius = _mm_loadu_ps(radii.data());
+        const __m128 limit = _mm_add_ps(_mm_mul_ps(radius, radius), _mm_set1_ps(std::numeric_limits<float>::epsilon()));
+
+        return _mm_movemask_ps(_mm_cmple_ps(distance_squared, limit));
+    }
+}
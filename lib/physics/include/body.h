@@ -1,12 +1,14 @@
 ﻿#ifndef KUMA_ENGINE_LIB_PHYSICS_BODY_H_
 #define KUMA_ENGINE_LIB_PHYSICS_BODY_H_
 
+#include <cstdint>
+
 #include "common.h"
 #include "vec2.h"
 
 namespace physics
 {
-    enum class BodyType
+    enum class BodyType : std::uint8_t
     {
         Static,
         Kinematic,
@@ -18,24 +20,30 @@ namespace physics
     {
     private:
         BodyType type_ = BodyType::Dynamic;
+        bool is_awake_ = true; //Next to the type so both share the padding before the vectors
 
         //Linear components
         math::Vec2f position_ = math::Vec2f::Zero();
+        math::Vec2f previous_position_ = math::Vec2f::Zero(); //Position before the last Update
+        math::Vec2f step_start_position_ = math::Vec2f::Zero(); //Position at the start of the last fixed step, for rendering
         math::Vec2f velocity_ = math::Vec2f::Zero();
         math::Vec2f acceleration_ = math::Vec2f::Zero();
+        //Velocity only used to push overlapping bodies apart, it never feeds back into velocity_
+        math::Vec2f pseudo_velocity_ = math::Vec2f::Zero();
 
         //Angular components
         float orientation_ = 0.0f;
         float angular_velocity_ = 0.0f;
         float torque_ = 0.0f;
-
-        bool is_awake_ = true;
+        float pseudo_angular_velocity_ = 0.0f;
+        float step_start_orientation_ = 0.0f;
 
         float mass_ = 1.0f;
         float inverse_mass_ = 1.0f;
 
-        float inertia_ = 1.0f;
-        float inverse_inertia_ = 1.0f;
+        //An inverse inertia of zero means the body has a fixed rotation
+        float inertia_ = 0.0f;
+        float inverse_inertia_ = 0.0f;
 
     public:
         Body() = default;
@@ -44,6 +52,8 @@ namespace physics
         {
             type_ = type;
             position_ = position;
+            previous_position_ = position;
+            step_start_position_ = position;
             velocity_ = velocity;
             mass_ = mass;
 
@@ -51,6 +61,8 @@ namespace physics
             {
                 velocity_ = math::Vec2f::Zero();
                 mass_ = 0.0f;
+                inertia_ = 0.0f;
+                inverse_inertia_ = 0.0f;
             }
 
             if (mass_ == 0.0f)
@@ -66,6 +78,8 @@ namespace physics
         Body(const math::Vec2f position, const float mass)
         {
             position_ = position;
+            previous_position_ = position;
+            step_start_position_ = position;
             mass_ = mass;
             inverse_mass_ = 1.0f / mass;
         };
@@ -73,11 +87,14 @@ namespace physics
         //Getters
         [[nodiscard]] BodyType type() const { return type_; }
         [[nodiscard]] math::Vec2f position() const { return position_; }
+        [[nodiscard]] math::Vec2f previous_position() const { return previous_position_; }
         [[nodiscard]] math::Vec2f velocity() const { return velocity_; }
         [[nodiscard]] math::Vec2f acceleration() const { return acceleration_; }
+        [[nodiscard]] math::Vec2f pseudo_velocity() const { return pseudo_velocity_; }
         [[nodiscard]] float orientation() const { return orientation_; }
         [[nodiscard]] float angular_velocity() const { return angular_velocity_; }
         [[nodiscard]] float torque() const { return torque_; }
+        [[nodiscard]] float pseudo_angular_velocity() const { return pseudo_angular_velocity_; }
         [[nodiscard]] float mass() const { return mass_; }
         [[nodiscard]] float inverse_mass() const { return inverse_mass_; }
         [[nodiscard]] float inertia() const { return inertia_; }
@@ -87,6 +104,8 @@ namespace physics
         //Setters
         void set_position(const math::Vec2f new_position) { position_ = new_position; }
         void set_velocity(const math::Vec2f new_velocity) { velocity_ = new_velocity; }
+        void set_orientation(const float new_orientation) { orientation_ = new_orientation; }
+        void set_angular_velocity(const float new_angular_velocity) { angular_velocity_ = new_angular_velocity; }
 
         void set_mass(const float new_mass)
         {
@@ -101,6 +120,22 @@ namespace physics
             }
         }
 
+        //Setting an inertia of zero locks the rotation of the body
+        void set_inertia(const float new_inertia)
+        {
+            if (type_ == BodyType::Static) { return; }
+
+            inertia_ = new_inertia;
+            if (new_inertia == 0.0f)
+            {
+                inverse_inertia_ = 0.0f;
+            }
+            else
+            {
+                inverse_inertia_ = 1.0f / new_inertia;
+            }
+        }
+
         void set_type(const BodyType new_type)
         {
             type_ = new_type;
@@ -109,9 +144,31 @@ namespace physics
                 velocity_ = math::Vec2f::Zero();
                 mass_ = 0.0f;
                 inverse_mass_ = 0.0f;
+                angular_velocity_ = 0.0f;
+                inertia_ = 0.0f;
+                inverse_inertia_ = 0.0f;
             }
         }
 
+        //Called by the scenes before a fixed step, a step may run several Updates when it has substeps
+        void SaveStepStart()
+        {
+            step_start_position_ = position_;
+            step_start_orientation_ = orientation_;
+        }
+
+        //State between the start of the last fixed step (alpha 0) and now (alpha 1), to render between steps
+        [[nodiscard]] math::Vec2f InterpolatedPosition(const float alpha) const
+        {
+            return step_start_position_.LERP(position_, alpha);
+        }
+        [[nodiscard]] float InterpolatedOrientation(const float alpha) const
+        {
+            return step_start_orientation_ + (orientation_ - step_start_orientation_) * alpha;
+        }
+
+        [[nodiscard]] bool has_fixed_rotation() const { return inverse_inertia_ == 0.0f; }
+
         void ApplyForce(const math::Vec2f force)
         {
             if (type_ == BodyType::Dynamic)
@@ -132,6 +189,43 @@ namespace physics
             }
         }
 
+        //Impulse applied at contact_vector, relative to the centre of mass
+        void ApplyImpulse(const math::Vec2f& impulse, const math::Vec2f& contact_vector)
+        {
+            if (type_ == BodyType::Dynamic)
+            {
+                velocity_ += impulse * inverse_mass_;
+                angular_velocity_ += inverse_inertia_ * math::Vec2f::Cross(contact_vector, impulse);
+            }
+        }
+
+        //Split impulse, only changes the pseudo-velocities used by the position correction
+        void ApplyPseudoImpulse(const math::Vec2f& impulse, const math::Vec2f& contact_vector)
+        {
+            if (type_ == BodyType::Dynamic)
+            {
+                pseudo_velocity_ += impulse * inverse_mass_;
+                pseudo_angular_velocity_ += inverse_inertia_ * math::Vec2f::Cross(contact_vector, impulse);
+            }
+        }
+
+        //Moves the body by its pseudo-velocities, then drops them so they do not carry over to the next step
+        void IntegratePseudoVelocity(const float delta_time)
+        {
+            position_ += pseudo_velocity_ * delta_time;
+            orientation_ += pseudo_angular_velocity_ * delta_time;
+            pseudo_velocity_ = math::Vec2f::Zero();
+            pseudo_angular_velocity_ = 0.0f;
+        }
+
+        void ApplyTorque(const float torque)
+        {
+            if (type_ == BodyType::Dynamic)
+            {
+                torque_ += torque;
+            }
+        }
+
         void ApplyGravity(const math::Vec2f gravity)
         {
             if (type_ == BodyType::Dynamic)
@@ -142,17 +236,31 @@ namespace physics
 
         void Update(const float delta_time)
         {
+            previous_position_ = position_;
             if (type_ != BodyType::Static)
             {
                     velocity_ += acceleration_ * delta_time;
 
                     position_ += velocity_ * delta_time;
 
+                    //Bodies with a fixed rotation skip the angular integration entirely
+                    if (inverse_inertia_ != 0.0f)
+                    {
+                        angular_velocity_ += torque_ * inverse_inertia_ * delta_time;
+                    }
+                    if (angular_velocity_ != 0.0f)
+                    {
+                        orientation_ += angular_velocity_ * delta_time;
+                    }
             }
             ResetForce();
         }
 
-        void ResetForce() { acceleration_ = math::Vec2f::Zero(); }
+        void ResetForce()
+        {
+            acceleration_ = math::Vec2f::Zero();
+            torque_ = 0.0f;
+        }
     };
 }
 #endif //KUMA_ENGINE_LIB_PHYSICS_BODY_H_
@@ -1,74 +1,210 @@
 ﻿#ifndef KUMA_ENGINE_LIB_PHYSICS_COLLIDER_H_
 #define KUMA_ENGINE_LIB_PHYSICS_COLLIDER_H_
 
+#include <cassert>
+#include <cstdint>
+#include <type_traits>
 #include <variant>
 
 #include "shape.h"
 
 namespace physics
 {
+ //Layers a collider belongs to and layers it collides with
+ //Two colliders meet only when the mask of each one holds the category of the other
+ struct CollisionFilter
+ {
+  std::uint16_t category = 0x0001;
+  std::uint16_t mask = 0xFFFF;
+
+  [[nodiscard]] constexpr bool CanCollideWith(const CollisionFilter& other) const
+  {
+   return (mask & other.category) != 0 && (other.mask & category) != 0;
+  }
+
+  constexpr bool operator==(const CollisionFilter& other) const = default;
+ };
+
+ //Shape, material and trigger flag of a game object
+ //The shape is a tagged union over the ShapeType, every shape is stored inline so colliders copy without allocating
  class Collider
  {
  private:
-  std::variant<math::Circle, math::AABB, math::Polygon> shape_ = math::Circle(0);
+  union
+  {
+   math::Circle circle_;
+   math::AABB aabb_;
+   math::Polygon polygon_;
+  };
 
   float bounciness_ = 0.0f;
   float friction_ = 0.0f;
   float dynamic_friction_ = 0.0f;
   float offset_ = 0.0f;
 
+  //Motion expected over the coming step, the broad phase bounds cover it
+  math::Vec2f sweep_ = math::Vec2f::Zero();
+
+  CollisionFilter filter_{};
+  math::ShapeType shape_type_ = math::ShapeType::kCircle;
   bool is_trigger_ = false;
 
   public:
-  Collider() = default;
+  Collider() : circle_(0) {}
   Collider(const std::variant<math::Circle, math::AABB, math::Polygon>& shape, const float bounciness, const float friction, const bool is_trigger)
+   : circle_(0)
   {
-   shape_ = shape;
+   set_shape(shape);
    bounciness_ = bounciness;
    friction_ = friction;
    dynamic_friction_ = friction * 0.5f;
    is_trigger_ = is_trigger;
   };
 
-  [[nodiscard]] std::variant<math::Circle, math::AABB, math::Polygon> shape() const { return shape_; }
+  //Calls function with a reference to the active shape, a switch on the tag instead of a variant copy
+  template <typename Function>
+  decltype(auto) Visit(Function&& function) const {
+   switch (shape_type_)
+   {
+   case math::ShapeType::kAABB: return function(aabb_);
+   case math::ShapeType::kPolygon: return function(polygon_);
+   case math::ShapeType::kCircle:
+   default: return function(circle_);
+   }
+  }
+
+  template <typename Function>
+  decltype(auto) Visit(Function&& function) {
+   switch (shape_type_)
+   {
+   case math::ShapeType::kAABB: return function(aabb_);
+   case math::ShapeType::kPolygon: return function(polygon_);
+   case math::ShapeType::kCircle:
+   default: return function(circle_);
+   }
+  }
+
+  //Copy of the active shape, no allocation since every shape is stored inline
+  [[nodiscard]] std::variant<math::Circle, math::AABB, math::Polygon> shape() const {
+   return Visit([](const auto& shape) { return std::variant<math::Circle, math::AABB, math::Polygon>(shape); });
+  }
+
+  //Typed access to the shape, the caller must know the shape type
+  [[nodiscard]] const math::Circle& circle() const {
+   assert(shape_type_ == math::ShapeType::kCircle && "Collider shape is not a circle");
+   return circle_;
+  }
+  [[nodiscard]] const math::AABB& aabb() const {
+   assert(shape_type_ == math::ShapeType::kAABB && "Collider shape is not an AABB");
+   return aabb_;
+  }
+  [[nodiscard]] const math::Polygon& polygon() const {
+   assert(shape_type_ == math::ShapeType::kPolygon && "Collider shape is not a polygon");
+   return polygon_;
+  }
+
   [[nodiscard]] float bounciness() const { return bounciness_; }
   [[nodiscard]] float friction() const { return friction_; }
   [[nodiscard]] float dynamic_friction() const { return dynamic_friction_; }
   [[nodiscard]] bool is_trigger() const { return is_trigger_; }
+  [[nodiscard]] CollisionFilter filter() const { return filter_; }
+  [[nodiscard]] math::Vec2f sweep() const { return sweep_; }
+  [[nodiscard]] bool is_swept() const { return sweep_.x != 0.0f || sweep_.y != 0.0f; }
 
-  void set_shape(const std::variant<math::Circle, math::AABB, math::Polygon>& shape){ shape_ = shape; }
+  void set_shape(const std::variant<math::Circle, math::AABB, math::Polygon>& shape) {
+   std::visit([this](const auto& value) {
+       using Shape = std::decay_t<decltype(value)>;
+       shape_type_ = Shape::GetShapeType();
+       if constexpr (std::is_same_v<Shape, math::Circle>) { circle_ = value; }
+       else if constexpr (std::is_same_v<Shape, math::AABB>) { aabb_ = value; }
+       else { polygon_ = value; }
+   }, shape);
+  }
   void set_bounciness(const float restitution){ bounciness_ = restitution; }
   void set_friction(const float friction){ friction_ = friction; }
   void set_is_trigger(const bool is_trigger){ is_trigger_ = is_trigger; }
+  void set_filter(const CollisionFilter filter){ filter_ = filter; }
+  void set_sweep(const math::Vec2f sweep){ sweep_ = sweep; }
+
+  //Corners of the shape bounds, no square root unlike a full math::AABB
+  [[nodiscard]] math::Bounds2f GetBoundingBox() const {
+   return Visit([](const auto& shape) {
+       return shape.GetBounds();
+   });
+  }
 
-  [[nodiscard]] math::AABB GetBoundingBox() const {
-   return std::visit([](auto&& shape) {
-       return shape.GetBoundingBox();
-   }, shape_);
+  //Bounds covering the whole motion of the step, from the current position to the swept one
+  [[nodiscard]] math::Bounds2f GetSweptBoundingBox() const {
+   const math::Bounds2f bounds = GetBoundingBox();
+   return is_swept() ? bounds.Swept(sweep_) : bounds;
   }
 
-  [[nodiscard]] math::ShapeType GetShapeType() const {
-   return std::visit([](auto&& shape) {
-       return shape.GetShapeType();
-   }, shape_);
+  [[nodiscard]] math::ShapeType GetShapeType() const { return shape_type_; }
+
+  [[nodiscard]] bool ShouldCollide(const Collider& other) const { return filter_.CanCollideWith(other.filter_); }
+
+  [[nodiscard]] float CalculateInertia(const float mass) const {
+   return Visit([mass](const auto& shape) {
+       return shape.CalculateInertia(mass);
+   });
   }
 
   void UpdatePosition(const math::Vec2f position) {
-   std::visit([&position](auto&& shape) {
+   Visit([&position](auto& shape) {
        shape.UpdatePosition(position);
-   }, shape_);
+   });
+  }
+
+  //Circles and AABBs ignore the orientation, polygons rotate with their body
+  void UpdateTransform(const math::Vec2f position, const float orientation) {
+   Visit([&position, orientation](auto& shape) {
+       if constexpr (requires { shape.set_transform(position, orientation); })
+       {
+           shape.set_transform(position, orientation);
+       }
+       else
+       {
+           shape.UpdatePosition(position);
+       }
+   });
   }
 
   bool operator==(const Collider& other) const
   {
-   return shape_ == other.shape_ &&
+   if (shape_type_ != other.shape_type_) { return false; }
+
+   bool same_shape = false;
+   switch (shape_type_)
+   {
+   case math::ShapeType::kAABB: same_shape = aabb_ == other.aabb_; break;
+   case math::ShapeType::kPolygon: same_shape = polygon_ == other.polygon_; break;
+   case math::ShapeType::kCircle:
+   default: same_shape = circle_ == other.circle_; break;
+   }
+
+   return same_shape &&
           bounciness_ == other.bounciness_ &&
           friction_ == other.friction_ &&
           offset_ == other.offset_ &&
-          is_trigger_ == other.is_trigger_;
+          is_trigger_ == other.is_trigger_ &&
+          filter_ == other.filter_;
   }
  };
 
+ //The small members pack behind the largest shape, a polygon of kMaxPolygonVertices local vertices and normals
+ static_assert(sizeof(Collider) <= sizeof(math::Polygon) + 32, "Collider should only add its material and filter to the shape");
+
+ //Calls function with the shapes of both colliders by reference, one switch per collider
+ template <typename Function>
+ decltype(auto) VisitShapes(const Collider& collider_a, const Collider& collider_b, Function&& function)
+ {
+  return collider_a.Visit([&collider_b, &function](const auto& shape_a) -> decltype(auto) {
+      return collider_b.Visit([&shape_a, &function](const auto& shape_b) -> decltype(auto) {
+          return function(shape_a, shape_b);
+      });
+  });
+ }
+
 }
 
 #endif //KUMA_ENGINE_LIB_PHYSICS_COLLIDER_H_
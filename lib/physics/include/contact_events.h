@@ -0,0 +1,77 @@
+#ifndef KUMA_ENGINE_LIB_PHYSICS_CONTACT_EVENTS_H_
+#define KUMA_ENGINE_LIB_PHYSICS_CONTACT_EVENTS_H_
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "vec2.h"
+
+namespace physics
+{
+    static constexpr std::size_t kDefaultContactEventCapacity = 1024;
+
+    enum class ContactEventKind : std::uint8_t
+    {
+        kBegin,
+        kStay,
+        kEnd
+    };
+
+    //Contact of two objects during a step, the normal points from B to A
+    //The impulse is the normal impulse applied by the velocity solver, zero for triggers and for ended contacts
+    template <typename Handle>
+    struct ContactEvent
+    {
+        Handle handle_a{};
+        Handle handle_b{};
+        math::Vec2f normal = math::Vec2f::Zero();
+        float impulse = 0.0f;
+        ContactEventKind kind = ContactEventKind::kBegin;
+    };
+
+    //Events written by a scene during its steps and read once the steps are done
+    //The storage is reserved up front and kept when drained, so recording does not allocate in steady state
+    template <typename Handle>
+    class ContactEventQueue
+    {
+    private:
+        std::vector<ContactEvent<Handle>> events_;
+
+    public:
+        explicit ContactEventQueue(const std::size_t capacity = kDefaultContactEventCapacity)
+        {
+            events_.reserve(capacity);
+        }
+
+        void Push(const ContactEvent<Handle>& event) { events_.push_back(event); }
+
+        [[nodiscard]] std::span<const ContactEvent<Handle>> events() const { return events_; }
+        [[nodiscard]] std::size_t size() const { return events_.size(); }
+        [[nodiscard]] bool empty() const { return events_.empty(); }
+
+        //Hands every event to the consumer in recording order, then empties the queue
+        template <typename Consumer>
+        void Drain(Consumer&& consumer)
+        {
+            for (const auto& event : events_)
+            {
+                consumer(event);
+            }
+            events_.clear();
+        }
+
+        //Drops the events of a handle, for objects removed before the queue is drained
+        void Remove(const Handle handle)
+        {
+            std::erase_if(events_, [handle](const ContactEvent<Handle>& event)
+            {
+                return event.handle_a == handle || event.handle_b == handle;
+            });
+        }
+
+        void Clear() { events_.clear(); }
+    };
+}
+
+#endif //KUMA_ENGINE_LIB_PHYSICS_CONTACT_EVENTS_H_
@@ -5,19 +5,42 @@
 #include <utility>
 
 #include "game_object.h"
+#include "manifold.h"
 #include "shape.h"
+#include "solver_settings.h"
 #include "vec2.h"
 
 namespace physics
 {
+    struct ContactPoint
+    {
+        math::Vec2f position = math::Vec2f::Zero();
+        float penetration = 0.0f;
+
+        //Split impulse data, contact vectors and effective mass along the normal stay valid for the whole solve
+        math::Vec2f r_a = math::Vec2f::Zero();
+        math::Vec2f r_b = math::Vec2f::Zero();
+        float normal_mass = 0.0f;
+        float pseudo_impulse = 0.0f;
+    };
+
     struct ContactSolver
     {
         std::array<GameObject*, 2> objects_{};
 
-        math::Vec2f contact_point_ = math::Vec2f::Zero();
         math::Vec2f contact_normal_ = math::Vec2f::Zero();
 
-        float penetration_ = 0.0f;
+        //Polygon faces touch at up to two points, the other shapes at one
+        std::array<ContactPoint, 2> points_{};
+        int point_count_ = 0;
+
+        //Separating axis cache of the pair, used by polygon manifolds
+        math::SatCache* sat_cache_ = nullptr;
+        //Faces found by the narrow phase test of the pair, only set while PrepareContact computes the manifold
+        const math::SatQuery* sat_query_ = nullptr;
+
+        //Sum of the normal impulses applied by the velocity solver since the contact was prepared, reported by contact events
+        float normal_impulse_ = 0.0f;
 
         void SetContactObjects(const GameObjectPair& pair)
         {
@@ -25,89 +48,191 @@ namespace physics
             objects_[1] = pair.gameObjectB_;
         }
 
-        void ResolveContact()
+        //Solves a single contact on its own, batched contacts go through ResolveVelocities and ResolvePseudoVelocities
+        void ResolveContact(const SolverSettings& settings = {})
+        {
+            PrepareContact();
+            ResolveVelocities();
+            ResolvePositions(settings);
+        }
+
+        //Computes the contact data, so the contact can then be solved over several iterations
+        //A polygon pair passes the query of its overlap test, so the manifold does not run the SAT again
+        void PrepareContact(math::SatCache* sat_cache = nullptr, const math::SatQuery* sat_query = nullptr)
         {
+            sat_cache_ = sat_cache;
+            sat_query_ = sat_query;
+            normal_impulse_ = 0.0f;
             CalculateProperties();
+            sat_query_ = nullptr;
             if(objects_[0]->body().type() == BodyType::Static)
             {
                 std::swap(objects_[0], objects_[1]);
                 contact_normal_ = -contact_normal_;
             }
-            ResolveVelocities();
-            ResolvePositions();
+
+            const auto& body_a = objects_[0]->body();
+            const auto& body_b = objects_[1]->body();
+            for (int i = 0; i < point_count_; ++i)
+            {
+                auto& point = points_[i];
+                point.r_a = point.position - body_a.position();
+                point.r_b = point.position - body_b.position();
+                const float r_a_cross_n = math::Vec2f::Cross(point.r_a, contact_normal_);
+                const float r_b_cross_n = math::Vec2f::Cross(point.r_b, contact_normal_);
+                const float inverse_mass_sum = body_a.inverse_mass() + body_b.inverse_mass()
+                    + r_a_cross_n * r_a_cross_n * body_a.inverse_inertia()
+                    + r_b_cross_n * r_b_cross_n * body_b.inverse_inertia();
+                point.normal_mass = inverse_mass_sum > std::numeric_limits<float>::epsilon() ? 1.0f / inverse_mass_sum : 0.0f;
+                point.pseudo_impulse = 0.0f;
+            }
         }
 
-    private:
-        void CalculateProperties()
+        //Moves both objects back to the time of impact within their last update, solves the contact there,
+        //then moves them with their new velocities for the rest of the update
+        void ResolveContactAt(const float time_of_impact, const float delta_time)
         {
-            const auto collider_a = objects_[0]->collider();
-            const auto collider_b = objects_[1]->collider();
+            for (auto* object : objects_)
+            {
+                auto& body = object->body();
+                const math::Vec2f position = body.previous_position().LERP(body.position(), time_of_impact);
+                body.set_position(position);
+                object->collider().UpdatePosition(position);
+            }
 
-            //Reset properties
-            contact_point_ = math::Vec2f::Zero();
-            contact_normal_ = math::Vec2f::Zero();
-            penetration_ = 0.0f;
+            PrepareContact();
+            ResolveVelocities();
 
-            switch (collider_a.GetShapeType())
+            const float remaining_time = (1.0f - time_of_impact) * delta_time;
+            for (auto* object : objects_)
             {
-            case math::ShapeType::kAABB:
-                switch (collider_b.GetShapeType())
-                {
-                case math::ShapeType::kAABB:
-                    HandleAABBAABBCollision();
-                    break;
-                case math::ShapeType::kCircle:
-                    HandleAABBCircleCollision();
-                    break;
-                case math::ShapeType::kPolygon:
-                    HandleAABBPolygonCollision();
-                    break;
-                case math::ShapeType::kNone:
-                default:
-                    break;
-                }
-                break;
-            case math::ShapeType::kCircle:
-                switch (collider_b.GetShapeType())
+                auto& body = object->body();
+                if (body.type() != BodyType::Static)
                 {
-                case math::ShapeType::kAABB:
-                    std::swap(objects_[0], objects_[1]);
-                    CalculateProperties();
-                    break;
-                case math::ShapeType::kCircle:
-                    HandleCircleCircleCollision();
-                    break;
-                case math::ShapeType::kPolygon:
-                    HandleCirclePolygonCollision();
-                    break;
-                case math::ShapeType::kNone:
-                default:
-                    break;
+                    body.set_position(body.position() + body.velocity() * remaining_time);
                 }
-                break;
-            case math::ShapeType::kPolygon:
-                switch (collider_b.GetShapeType())
+                object->collider().UpdatePosition(body.position());
+            }
+        }
+
+        void ResolveVelocities()
+        {
+            //Non-rotating pairs keep the cheaper centre of mass impulse
+            if (objects_[0]->body().has_fixed_rotation() && objects_[1]->body().has_fixed_rotation())
+            {
+                ResolveLinearVelocities();
+            }
+            else
+            {
+                for (int i = 0; i < point_count_; ++i)
                 {
-                case math::ShapeType::kAABB:
-                case math::ShapeType::kCircle:
-                    std::swap(objects_[0], objects_[1]);
-                    CalculateProperties();
-                    break;
-                case math::ShapeType::kPolygon:
-                    HandlePolygonPolygonCollision();
-                    break;
-                case math::ShapeType::kNone:
-                default:
-                    break;
+                    ResolveAngularVelocities(points_[i]);
                 }
-                break;
-            case math::ShapeType::kNone:
-            default:
-                break;
             }
         }
 
-        void ResolveVelocities() const
+        //Split impulse position correction, one iteration over the pseudo-velocities of both bodies
+        //The accumulated impulse is clamped so the solver only ever pushes the bodies apart
+        void ResolvePseudoVelocities(const float inverse_delta_time, const SolverSettings& settings)
+        {
+            auto& body_a = objects_[0]->body();
+            auto& body_b = objects_[1]->body();
+
+            for (int i = 0; i < point_count_; ++i)
+            {
+                auto& point = points_[i];
+                const float depth = point.penetration - settings.linear_slop;
+                if (depth <= 0.0f || point.normal_mass == 0.0f) { continue; }
+
+                const math::Vec2f relative_velocity = body_a.pseudo_velocity() + math::Vec2f::Cross(body_a.pseudo_angular_velocity(), point.r_a)
+                    - body_b.pseudo_velocity() - math::Vec2f::Cross(body_b.pseudo_angular_velocity(), point.r_b);
+                const float separating_velocity = math::Vec2f::Dot(relative_velocity, contact_normal_);
+
+                //Separating speed that removes the wanted part of the penetration during this step
+                const float bias = settings.position_correction * depth * inverse_delta_time;
+
+                const float previous_impulse = point.pseudo_impulse;
+                point.pseudo_impulse = std::max(previous_impulse + (bias - separating_velocity) * point.normal_mass, 0.0f);
+                const math::Vec2f impulse = (point.pseudo_impulse - previous_impulse) * contact_normal_;
+
+                body_a.ApplyPseudoImpulse(impulse, point.r_a);
+                body_b.ApplyPseudoImpulse(-impulse, point.r_b);
+            }
+        }
+
+        //Moves both bodies by their pseudo-velocities once the position iterations are done
+        void IntegratePseudoVelocities(const float delta_time) const
+        {
+            for (auto* object : objects_)
+            {
+                auto& body = object->body();
+                if (body.pseudo_velocity() == math::Vec2f::Zero() && body.pseudo_angular_velocity() == 0.0f) { continue; }
+
+                body.IntegratePseudoVelocity(delta_time);
+                object->collider().UpdateTransform(body.position(), body.orientation());
+            }
+        }
+
+        //Direct position projection for contacts solved on their own, outside of a batch
+        void ResolvePositions(const SolverSettings& settings) const
+        {
+            float penetration = 0.0f;
+            for (int i = 0; i < point_count_; ++i) { penetration = std::max(penetration, points_[i].penetration); }
+
+            const float depth = penetration - settings.linear_slop;
+            if (depth <= 0.0f) { return; }
+
+            auto& body_a = objects_[0]->body();
+            auto& body_b = objects_[1]->body();
+            const auto inverse_mass_a = body_a.inverse_mass();
+            const auto inverse_mass_b = body_b.inverse_mass();
+            const auto total_inverse_mass = inverse_mass_a + inverse_mass_b;
+            if(total_inverse_mass <= std::numeric_limits<float>::epsilon()) { return; }
+
+            const math::Vec2f correction = contact_normal_ * (depth * settings.position_correction / total_inverse_mass);
+
+            // only move the dynamic bodies
+            if (body_a.type() != BodyType::Static)
+            {
+                body_a.set_position(body_a.position() + correction * inverse_mass_a);
+            }
+            if (body_b.type() != BodyType::Static)
+            {
+                body_b.set_position(body_b.position() - correction * inverse_mass_b);
+            }
+        }
+
+    private:
+        void CalculateProperties()
+        {
+            //Reset properties, every shape pair but polygon faces gives a single point
+            contact_normal_ = math::Vec2f::Zero();
+            points_ = {};
+            point_count_ = 1;
+
+            //Handlers indexed by the shape types of A and B, the pairs stored the other way round swap the objects first
+            using ShapeHandler = void (ContactSolver::*)();
+            static constexpr size_t kShapeTypeCount = static_cast<size_t>(math::ShapeType::kNone);
+            static constexpr std::array<std::array<ShapeHandler, kShapeTypeCount>, kShapeTypeCount> kShapeHandlers = {{
+                {&ContactSolver::HandleAABBAABBCollision, &ContactSolver::HandleAABBCircleCollision, &ContactSolver::HandleAABBPolygonCollision},
+                {&ContactSolver::HandleSwappedCollision, &ContactSolver::HandleCircleCircleCollision, &ContactSolver::HandleCirclePolygonCollision},
+                {&ContactSolver::HandleSwappedCollision, &ContactSolver::HandleSwappedCollision, &ContactSolver::HandlePolygonPolygonCollision},
+            }};
+
+            const auto type_a = static_cast<size_t>(objects_[0]->collider().GetShapeType());
+            const auto type_b = static_cast<size_t>(objects_[1]->collider().GetShapeType());
+            if (type_a >= kShapeTypeCount || type_b >= kShapeTypeCount) { return; }
+
+            (this->*kShapeHandlers[type_a][type_b])();
+        }
+
+        void HandleSwappedCollision()
+        {
+            std::swap(objects_[0], objects_[1]);
+            CalculateProperties();
+        }
+
+        void ResolveLinearVelocities()
         {
             auto& body_a = objects_[0]->body();
             auto& body_b = objects_[1]->body();
@@ -129,6 +254,7 @@ namespace physics
             // Calculate impulse scalar
             float impulse_magnitude = -(1.0f + restitution) * separating_velocity;
             impulse_magnitude /= (body_a.inverse_mass() + body_b.inverse_mass());
+            normal_impulse_ += impulse_magnitude;
             math::Vec2f impulse = impulse_magnitude * contact_normal_;
 
             // // Debug output
@@ -181,49 +307,81 @@ namespace physics
             }
         }
 
-        void ResolvePositions() const
+        void ResolveAngularVelocities(const ContactPoint& point)
         {
-            if (penetration_ <= 0.0f) { return; }
-
             auto& body_a = objects_[0]->body();
             auto& body_b = objects_[1]->body();
-            const auto inverse_mass_a = body_a.inverse_mass();
-            const auto inverse_mass_b = body_b.inverse_mass();
-            const auto total_inverse_mass = inverse_mass_a + inverse_mass_b;
-            if(total_inverse_mass <= std::numeric_limits<float>::epsilon()) { return; }
 
-            //Correct positions to avoid objects sinking into each other
-            //Only correct position if the penetration is above this threshold
-            float penetration_correction = std::max(penetration_, 0.01f);
-            constexpr float correction_percent = 0.8f;
-            const math::Vec2f correction = contact_normal_ * (penetration_correction * correction_percent);
+            const auto& collider_a = objects_[0]->collider();
+            const auto& collider_b = objects_[1]->collider();
 
-            //// Debug output
-            // std::cout << "ResolvePositions:" << std::endl;
-            // std::cout << "  Penetration: " << penetration_ << std::endl;
-            // std::cout << "  Correction: " << correction.x << " : " << correction.y << std::endl;
-            // std::cout << "  Body A Position Before: " << body_a.position().x << " : " << body_a.position().y << std::endl;
-            // std::cout << "  Body B Position Before: " << body_b.position().x << " : " << body_b.position().y << std::endl;
+            //Contact point relative to each centre of mass
+            const math::Vec2f& r_a = point.r_a;
+            const math::Vec2f& r_b = point.r_b;
 
-            // only move the dynamic bodies
-            if (body_a.type() != BodyType::Static)
+            // Relative velocity at the contact point, including the rotation of each body
+            const math::Vec2f relative_velocity = body_a.velocity() + math::Vec2f::Cross(body_a.angular_velocity(), r_a)
+                - body_b.velocity() - math::Vec2f::Cross(body_b.angular_velocity(), r_b);
+
+            const float separating_velocity = math::Vec2f::Dot(relative_velocity, contact_normal_);
+
+            if (separating_velocity > 0.0f) { return; }
+
+            const float restitution = (collider_a.bounciness() * body_a.mass() + collider_b.bounciness() * body_b.mass()) / (body_a.mass() + body_b.mass());
+
+            // Effective mass along the normal, with the r x n terms of each body
+            const float r_a_cross_n = math::Vec2f::Cross(r_a, contact_normal_);
+            const float r_b_cross_n = math::Vec2f::Cross(r_b, contact_normal_);
+            const float inverse_mass_sum = body_a.inverse_mass() + body_b.inverse_mass()
+                + r_a_cross_n * r_a_cross_n * body_a.inverse_inertia()
+                + r_b_cross_n * r_b_cross_n * body_b.inverse_inertia();
+            if (inverse_mass_sum <= std::numeric_limits<float>::epsilon()) { return; }
+
+            const float impulse_magnitude = -(1.0f + restitution) * separating_velocity / inverse_mass_sum;
+            const math::Vec2f impulse = impulse_magnitude * contact_normal_;
+            normal_impulse_ += impulse_magnitude;
+
+            body_a.ApplyImpulse(impulse, r_a);
+            body_b.ApplyImpulse(-impulse, r_b);
+
+            //Friction, with the velocities updated by the normal impulse
+            const math::Vec2f new_relative_velocity = body_a.velocity() + math::Vec2f::Cross(body_a.angular_velocity(), r_a)
+                - body_b.velocity() - math::Vec2f::Cross(body_b.angular_velocity(), r_b);
+            const math::Vec2f tangent = (new_relative_velocity - math::Vec2f::Dot(new_relative_velocity, contact_normal_) * contact_normal_).Normalized();
+            if (tangent == math::Vec2f::Zero()) { return; }
+
+            const float r_a_cross_t = math::Vec2f::Cross(r_a, tangent);
+            const float r_b_cross_t = math::Vec2f::Cross(r_b, tangent);
+            const float tangent_mass_sum = body_a.inverse_mass() + body_b.inverse_mass()
+                + r_a_cross_t * r_a_cross_t * body_a.inverse_inertia()
+                + r_b_cross_t * r_b_cross_t * body_b.inverse_inertia();
+
+            const float jt = -math::Vec2f::Dot(new_relative_velocity, tangent) / tangent_mass_sum;
+            const float mu = std::sqrt(
+                collider_a.friction() * collider_a.friction() + collider_b.friction() * collider_b.friction());
+
+            // Clamp friction
+            math::Vec2f friction_impulse = math::Vec2f::Zero();
+            if (std::abs(jt) < impulse_magnitude * mu)
             {
-                body_a.set_position(body_a.position() - correction * inverse_mass_a);
+                friction_impulse = jt * tangent;
             }
-            if (body_b.type() != BodyType::Static)
+            else
             {
-                body_b.set_position(body_b.position() + correction * inverse_mass_b) ;
+                const float dynamic_friction_impulse = std::sqrt(
+                    collider_a.dynamic_friction() * collider_a.dynamic_friction() + collider_b.dynamic_friction() *
+                    collider_b.dynamic_friction());
+                friction_impulse = -impulse_magnitude * tangent * dynamic_friction_impulse;
             }
-            // // Debug output after position correction
-            // std::cout << "  Body A Position After: " << body_a.position().x << " : " << body_a.position().y << std::endl;
-            // std::cout << "  Body B Position After: " << body_b.position().x << " : " << body_b.position().y << std::endl;
-            // std::cout << "-------------------------" << std::endl;
+
+            body_a.ApplyImpulse(friction_impulse, r_a);
+            body_b.ApplyImpulse(-friction_impulse, r_b);
         }
 
         void HandleAABBAABBCollision()
         {
-            const auto& aabb_a = std::get<math::AABB>(objects_[0]->collider().shape());
-            const auto& aabb_b = std::get<math::AABB>(objects_[1]->collider().shape());
+            const auto& aabb_a = objects_[0]->collider().aabb();
+            const auto& aabb_b = objects_[1]->collider().aabb();
             const auto centre_a = objects_[0]->position();
             const auto centre_b = objects_[1]->position();
 
@@ -236,17 +394,17 @@ namespace physics
             //Determine the smallest overlap direction
             if (overlap_x < overlap_y)
             {
-                penetration_ = overlap_x;
+                points_[0].penetration = overlap_x;
                 contact_normal_ = centre_a.x < centre_b.x ? math::Vec2f(-1, 0) : math::Vec2f(1, 0);
             }
             else
             {
-                penetration_ = overlap_y;
+                points_[0].penetration = overlap_y;
                 contact_normal_ = centre_a.y < centre_b.y ? math::Vec2f(0, -1) : math::Vec2f(0, 1);
             }
 
             //Calculate the contact point as the midpoint of the overlapping edges
-            contact_point_ = {
+            points_[0].position = {
                 std::clamp((centre_a.x + centre_b.x) / 2, aabb_a.min_bound().x, aabb_a.max_bound().x),
                 std::clamp((centre_a.y + centre_b.y) / 2, aabb_a.min_bound().y, aabb_a.max_bound().y)
             };
@@ -255,8 +413,8 @@ namespace physics
 
         void HandleAABBCircleCollision()
 {
-    const auto& aabb = std::get<math::AABB>(objects_[0]->collider().shape());
-    const auto& circle = std::get<math::Circle>(objects_[1]->collider().shape());
+    const auto& aabb = objects_[0]->collider().aabb();
+    const auto& circle = objects_[1]->collider().circle();
     const auto centre = circle.centre();
     const auto radius = circle.radius();
 
@@ -274,8 +432,8 @@ namespace physics
     {
         // Case: Circle's center is outside the AABB
         contact_normal_ = delta / distance; // Normalized vector
-        penetration_ = radius - distance;
-        contact_point_ = closest_point;
+        points_[0].penetration = radius - distance;
+        points_[0].position = closest_point;
     }
     else
     {
@@ -292,34 +450,37 @@ namespace physics
         if (min_dist == left_dist)
         {
             contact_normal_ = math::Vec2f(-1, 0); // Left edge
-            penetration_ = radius - left_dist;
-            contact_point_ = {aabb.min_bound().x, centre.y};
+            points_[0].penetration = radius - left_dist;
+            points_[0].position = {aabb.min_bound().x, centre.y};
         }
         else if (min_dist == right_dist)
         {
             contact_normal_ = math::Vec2f(1, 0); // Right edge
-            penetration_ = radius - right_dist;
-            contact_point_ = {aabb.max_bound().x, centre.y};
+            points_[0].penetration = radius - right_dist;
+            points_[0].position = {aabb.max_bound().x, centre.y};
         }
         else if (min_dist == bottom_dist)
         {
             contact_normal_ = math::Vec2f(0, -1); // Bottom edge
-            penetration_ = radius - bottom_dist;
-            contact_point_ = {centre.x, aabb.min_bound().y};
+            points_[0].penetration = radius - bottom_dist;
+            points_[0].position = {centre.x, aabb.min_bound().y};
         }
         else if (min_dist == top_dist)
         {
             contact_normal_ = math::Vec2f(0, 1); // Top edge
-            penetration_ = radius - top_dist;
-            contact_point_ = {centre.x, aabb.max_bound().y};
+            points_[0].penetration = radius - top_dist;
+            points_[0].position = {centre.x, aabb.max_bound().y};
         }
     }
 }
 
 
+        //Box and polygon faces touch like two polygons, so they share the clipped manifold
         void HandleAABBPolygonCollision()
         {
-            //Not Implemented
+            const math::Polygon box = math::Polygon::FromAABB(objects_[0]->collider().aabb());
+            const auto& polygon = objects_[1]->collider().polygon();
+            HandleManifold(box, polygon);
         }
 
         void HandleCircleCircleCollision()
@@ -335,27 +496,74 @@ namespace physics
             if (delta.Magnitude() < std::numeric_limits<float>::epsilon())
             {
                 contact_normal_ = math::Vec2f(1.0f, 0.0f); // Arbitrary normal
-                penetration_ = radius_a + radius_b;       // Total overlap
+                points_[0].penetration = radius_a + radius_b;       // Total overlap
             }
             else
             {
                 contact_normal_ = delta.Normalized();
-                penetration_ = radius_a + radius_b - delta.Magnitude();
+                points_[0].penetration = radius_a + radius_b - delta.Magnitude();
             }
 
-            contact_point_ = centre_a + contact_normal_ * radius_a;
+            //The normal points from B to A, so the contact lies on A's side facing B
+            points_[0].position = centre_a - contact_normal_ * radius_a;
         }
 
         void HandleCirclePolygonCollision()
         {
-            //Not Implemented
-            //This would involve checking the closest edge of the polygon to the circle and calculating the contact point, normal, and penetration depth
+            const auto& circle = objects_[0]->collider().circle();
+            const auto& polygon = objects_[1]->collider().polygon();
+            const math::Vec2f centre = circle.centre();
+            const auto centre_support = [centre](math::Vec2f) { return centre; };
+
+            //Distance from the centre to the polygon, the circle is its centre grown by the radius
+            math::Simplex simplex;
+            math::Vec2f closest = math::Vec2f::Zero();
+            const float distance = math::GjkDistance(centre_support, math::SupportFunction(polygon), simplex, closest);
+
+            if (distance > 0.0f)
+            {
+                contact_normal_ = closest / distance;
+                points_[0].penetration = circle.radius() - distance;
+                points_[0].position = centre - closest;
+            }
+            else
+            {
+                //The centre is inside the polygon, EPA gives the shortest way out
+                const math::Penetration penetration = math::Epa(centre_support, math::SupportFunction(polygon), simplex);
+                contact_normal_ = penetration.normal;
+                points_[0].penetration = penetration.depth + circle.radius();
+                points_[0].position = centre + penetration.normal * penetration.depth;
+            }
         }
 
         void HandlePolygonPolygonCollision()
         {
-            //Not Implemented
-            //This would involve checking for edge intersections and calculating the contact point, normal, and penetration depth
+            const auto& polygon_a = objects_[0]->collider().polygon();
+            const auto& polygon_b = objects_[1]->collider().polygon();
+            if (sat_query_ && sat_cache_)
+            {
+                SetManifold(math::CollidePolygons(polygon_a, polygon_b, *sat_cache_, *sat_query_));
+                return;
+            }
+            HandleManifold(polygon_a, polygon_b);
+        }
+
+        //Clipped manifold, so resting faces get a contact at both ends
+        void HandleManifold(const math::Polygon& polygon_a, const math::Polygon& polygon_b)
+        {
+            math::SatCache local_cache;
+            SetManifold(math::CollidePolygons(polygon_a, polygon_b, sat_cache_ ? *sat_cache_ : local_cache));
+        }
+
+        void SetManifold(const math::Manifold& manifold)
+        {
+            contact_normal_ = manifold.normal;
+            point_count_ = manifold.point_count;
+            for (int i = 0; i < point_count_; ++i)
+            {
+                points_[i].position = manifold.points[i];
+                points_[i].penetration = manifold.penetrations[i];
+            }
         }
     };
 }
@@ -3,11 +3,15 @@
 
 #include <SDL_render.h>
 
+#include <algorithm>
 #include <array>
+#include <cstdint>
 #include <memory>
 #include <vector>
 
+#include "bounds2.h"
 #include "collider.h"
+#include "profiler.h"
 #include "shape.h"
 
 namespace physics
@@ -17,12 +21,12 @@ namespace physics
 
     struct QuadtreeNode
     {
-        math::AABB bounding_box_{};
+        math::Bounds2f bounding_box_{};
         std::array<std::unique_ptr<QuadtreeNode>, 4> children_{}; //Unique pointers for automatic memory management
         std::vector<Collider*> colliders_; //Colliders stored in each node
         int depth_;
 
-        explicit QuadtreeNode(const math::AABB& box, const int depth = 0)
+        explicit QuadtreeNode(const math::Bounds2f& box, const int depth = 0)
             : bounding_box_(box), depth_(depth)
         {
         }
@@ -33,24 +37,25 @@ namespace physics
             math::Vec2f halfSize = (bounding_box_.max_bound() - bounding_box_.min_bound()) * 0.5f;
             math::Vec2f center = bounding_box_.min_bound() + halfSize;
 
-            children_[0] = std::make_unique<QuadtreeNode>(math::AABB(bounding_box_.min_bound(), center), depth_ + 1);
-            children_[1] = std::make_unique<QuadtreeNode>(math::AABB(math::Vec2f(center.x, bounding_box_.min_bound().y),
+            children_[0] = std::make_unique<QuadtreeNode>(math::Bounds2f(bounding_box_.min_bound(), center), depth_ + 1);
+            children_[1] = std::make_unique<QuadtreeNode>(math::Bounds2f(math::Vec2f(center.x, bounding_box_.min_bound().y),
                                                                      math::Vec2f(
                                                                          bounding_box_.max_bound().x, center.y)),
                                                           depth_ + 1);
-            children_[2] = std::make_unique<QuadtreeNode>(math::AABB(math::Vec2f(bounding_box_.min_bound().x, center.y),
+            children_[2] = std::make_unique<QuadtreeNode>(math::Bounds2f(math::Vec2f(bounding_box_.min_bound().x, center.y),
                                                                      math::Vec2f(
                                                                          center.x, bounding_box_.max_bound().y)),
                                                           depth_ + 1);
-            children_[3] = std::make_unique<QuadtreeNode>(math::AABB(center, bounding_box_.max_bound()), depth_ + 1);
+            children_[3] = std::make_unique<QuadtreeNode>(math::Bounds2f(center, bounding_box_.max_bound()), depth_ + 1);
         }
 
         //Insert a collider into this node or its children
         bool Insert(Collider* collider)
         {
-            math::AABB shapeAABB = collider->GetBoundingBox();
+            //Fast colliders are stored with the bounds of their whole motion
+            const math::Bounds2f shapeBounds = collider->GetSweptBoundingBox();
 
-            if (!bounding_box_.Contains(shapeAABB.min_bound()) || !bounding_box_.Contains(shapeAABB.max_bound()))
+            if (!bounding_box_.Contains(shapeBounds))
             {
                 return false;
             }
@@ -79,7 +84,8 @@ namespace physics
         }
 
         //Query colliders within a given area
-        void Query(const math::AABB& range, std::vector<Collider*>& foundColliders) const
+        //When a querying collider is given, it is skipped along with the colliders its filter rejects
+        void Query(const math::Bounds2f& range, const Collider* querier, std::vector<Collider*>& foundColliders) const
         {
             if (!math::Intersect(bounding_box_, range))
             {
@@ -88,7 +94,12 @@ namespace physics
 
             for (const auto& collider : colliders_)
             {
-                if (math::Intersect(collider->GetBoundingBox(), range))
+                if (collider == querier || (querier && !querier->ShouldCollide(*collider)))
+                {
+                    continue;
+                }
+
+                if (math::Intersect(collider->GetSweptBoundingBox(), range))
                 {
                     foundColliders.push_back(collider);
                 }
@@ -98,7 +109,34 @@ namespace physics
             {
                 if (child)
                 {
-                    child->Query(range, foundColliders);
+                    child->Query(range, querier, foundColliders);
+                }
+            }
+        }
+
+        //Adds this node and its children to node_count, and raises max_depth to the deepest of them
+        void CountNodes(std::uint32_t& node_count, std::uint32_t& max_depth) const
+        {
+            node_count++;
+            max_depth = std::max(max_depth, static_cast<std::uint32_t>(depth_));
+            for (const auto& child : children_)
+            {
+                if (child)
+                {
+                    child->CountNodes(node_count, max_depth);
+                }
+            }
+        }
+
+        //Appends the bounds of this node and of its children
+        void CollectBounds(std::vector<math::Bounds2f>& bounds) const
+        {
+            bounds.push_back(bounding_box_);
+            for (const auto& child : children_)
+            {
+                if (child)
+                {
+                    child->CollectBounds(bounds);
                 }
             }
         }
@@ -133,7 +171,7 @@ namespace physics
         std::unique_ptr<QuadtreeNode> root_;
 
     public:
-        explicit Quadtree(const math::AABB& boundary)
+        explicit Quadtree(const math::Bounds2f& boundary)
             : root_(std::make_unique<QuadtreeNode>(boundary))
         {
         }
@@ -146,13 +184,45 @@ namespace physics
             }
         }
 
-        [[nodiscard]] std::vector<Collider*> Query(const math::AABB& range) const
+        [[nodiscard]] std::vector<Collider*> Query(const math::Bounds2f& range) const
         {
+            PROFILE_ZONE();
             std::vector<Collider*> foundColliders;
-            root_->Query(range, foundColliders);
+            root_->Query(range, nullptr, foundColliders);
             return foundColliders;
         }
 
+        //Colliders that may touch collider over the step, filtered by layer while the tree is walked
+        [[nodiscard]] std::vector<Collider*> Query(const Collider& collider) const
+        {
+            PROFILE_ZONE();
+            std::vector<Collider*> foundColliders;
+            root_->Query(collider.GetSweptBoundingBox(), &collider, foundColliders);
+            return foundColliders;
+        }
+
+        //Size of the tree for the stats, walks every node so it is called once per build
+        void CountNodes(std::uint32_t& node_count, std::uint32_t& max_depth) const
+        {
+            node_count = 0;
+            max_depth = 0;
+            root_->CountNodes(node_count, max_depth);
+        }
+
+        //Bounds of every node, for drawing the tree away from the thread that builds it
+        void CollectBounds(std::vector<math::Bounds2f>& bounds) const
+        {
+            root_->CollectBounds(bounds);
+        }
+
+        //Same as Query, filling a buffer the caller keeps, so the queries of a step reuse one allocation
+        void Query(const Collider& collider, std::vector<Collider*>& found_colliders) const
+        {
+            PROFILE_ZONE();
+            found_colliders.clear();
+            root_->Query(collider.GetSweptBoundingBox(), &collider, found_colliders);
+        }
+
         void Clear()
         {
             root_ = std::make_unique<QuadtreeNode>(root_->bounding_box_);
@@ -0,0 +1,56 @@
+#ifndef KUMA_ENGINE_LIB_PHYSICS_SOLVER_SETTINGS_H_
+#define KUMA_ENGINE_LIB_PHYSICS_SOLVER_SETTINGS_H_
+
+#include <algorithm>
+
+namespace physics
+{
+    static constexpr int kMaxSubstepCount = 16;
+    static constexpr int kMaxSolverIterations = 16;
+
+    //Work done by a scene for each fixed step
+    //The broad phase runs once per step, then every substep integrates and solves the contacts of its pairs
+    struct SolverSettings
+    {
+        int substep_count = 1;
+        int velocity_iterations = 1;
+        int position_iterations = 1;
+
+        //Penetration, in pixels, allowed before the position solver pushes bodies apart, keeps resting contacts touching
+        float linear_slop = 0.5f;
+        //Fraction of the remaining penetration removed in each substep
+        float position_correction = 0.2f;
+
+        //Processes the pairs in sorted order and hashes the state after each step, so a seeded scene replays bit for bit
+        bool deterministic = false;
+
+        //Levels of work taken off by the adaptive step budget, the requested counts above are left as they are
+        int load_reduction = 0;
+
+        //Counts the scenes run, clamped to the solver limits and lowered by the load reduction
+        //Velocity iterations go first, then substeps, the position iterations are kept so overlaps still get resolved
+        [[nodiscard]] int VelocityIterations() const
+        {
+            return std::max(1, std::clamp(velocity_iterations, 1, kMaxSolverIterations) - load_reduction);
+        }
+
+        [[nodiscard]] int SubstepCount() const
+        {
+            const int velocity_reduction = std::clamp(velocity_iterations, 1, kMaxSolverIterations) - VelocityIterations();
+            return std::max(1, std::clamp(substep_count, 1, kMaxSubstepCount) - (load_reduction - velocity_reduction));
+        }
+
+        [[nodiscard]] int PositionIterations() const
+        {
+            return std::clamp(position_iterations, 1, kMaxSolverIterations);
+        }
+
+        //Reduction that brings both the velocity iterations and the substeps down to one
+        [[nodiscard]] int MaxLoadReduction() const
+        {
+            return std::clamp(velocity_iterations, 1, kMaxSolverIterations) - 1 + std::clamp(substep_count, 1, kMaxSubstepCount) - 1;
+        }
+    };
+}
+
+#endif //KUMA_ENGINE_LIB_PHYSICS_SOLVER_SETTINGS_H_
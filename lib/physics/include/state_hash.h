@@ -0,0 +1,51 @@
+#ifndef KUMA_ENGINE_LIB_PHYSICS_STATE_HASH_H_
+#define KUMA_ENGINE_LIB_PHYSICS_STATE_HASH_H_
+
+#include <bit>
+#include <cstdint>
+
+#include "body.h"
+#include "vec2.h"
+
+namespace physics
+{
+    //FNV-1a over the bits of the simulated state, two runs with equal hashes went through bit-identical steps
+    class StateHash
+    {
+    private:
+        static constexpr std::uint64_t kOffsetBasis = 14695981039346656037ull;
+        static constexpr std::uint64_t kPrime = 1099511628211ull;
+
+        std::uint64_t value_ = kOffsetBasis;
+
+    public:
+        constexpr void Add(const std::uint32_t bits)
+        {
+            for (int shift = 0; shift < 32; shift += 8)
+            {
+                value_ ^= (bits >> shift) & 0xFFu;
+                value_ *= kPrime;
+            }
+        }
+
+        constexpr void Add(const float value) { Add(std::bit_cast<std::uint32_t>(value)); }
+
+        constexpr void Add(const math::Vec2f value)
+        {
+            Add(value.x);
+            Add(value.y);
+        }
+
+        void Add(const Body& body)
+        {
+            Add(body.position());
+            Add(body.velocity());
+            Add(body.orientation());
+            Add(body.angular_velocity());
+        }
+
+        [[nodiscard]] constexpr std::uint64_t value() const { return value_; }
+    };
+}
+
+#endif //KUMA_ENGINE_LIB_PHYSICS_STATE_HASH_H_
@@ -0,0 +1,142 @@
+#ifndef KUMA_ENGINE_LIB_PHYSICS_STATS_H_
+#define KUMA_ENGINE_LIB_PHYSICS_STATS_H_
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string_view>
+
+namespace physics
+{
+    //Phases of a fixed step, in the order the scenes run them
+    enum class Phase : std::uint8_t
+    {
+        kBroadPhase,
+        kIntegrate,
+        kContinuousCollision,
+        kNarrowPhase,
+        kSolve,
+        kEvents,
+        kCount
+    };
+
+    static constexpr std::size_t kPhaseCount = static_cast<std::size_t>(Phase::kCount);
+
+    static constexpr std::array<std::string_view, kPhaseCount> kPhaseNames = {
+        "broad phase", "integrate", "continuous collision", "narrow phase", "solve", "events"
+    };
+
+    //Work done by a scene during one step, only plain counters so they can stay on in release builds
+    struct StepCounters
+    {
+        std::array<float, kPhaseCount> phase_microseconds{};
+        std::uint32_t candidate_pairs = 0; //Pairs found by the broad phase
+        std::uint32_t narrow_phase_hits = 0; //Pairs whose shapes touch, summed over the substeps
+        std::uint32_t quadtree_nodes = 0;
+        std::uint32_t quadtree_depth = 0;
+        std::uint32_t quadtree_queries = 0;
+        std::uint32_t solver_iterations = 0; //Velocity and position iterations, summed over the substeps
+
+        [[nodiscard]] float StepMicroseconds() const
+        {
+            float sum = 0.0f;
+            for (const float microseconds : phase_microseconds)
+            {
+                sum += microseconds;
+            }
+            return sum;
+        }
+    };
+
+    //Time a scene spent in each phase, summed over the steps since the last reset,
+    //with the counters of the step being run and of the last finished one
+    struct Stats
+    {
+        std::array<double, kPhaseCount> phase_seconds{};
+        std::uint64_t step_count = 0;
+        StepCounters step{};
+        StepCounters last_step{};
+
+        [[nodiscard]] double& operator[](const Phase phase) { return phase_seconds[static_cast<std::size_t>(phase)]; }
+        [[nodiscard]] double operator[](const Phase phase) const { return phase_seconds[static_cast<std::size_t>(phase)]; }
+
+        void BeginStep() { step = StepCounters(); }
+
+        void EndStep()
+        {
+            last_step = step;
+            step_count++;
+        }
+
+        void Reset() { *this = Stats(); }
+    };
+
+    static constexpr std::size_t kStatsHistoryLength = 240;
+
+    //Rolling record of the last steps of a scene, one sample per finished step
+    //The series are ring buffers, read from offset() onwards as ImGui::PlotLines expects
+    class StatsHistory
+    {
+    private:
+        std::array<std::array<float, kStatsHistoryLength>, kPhaseCount> phase_microseconds_{};
+        std::array<float, kStatsHistoryLength> step_microseconds_{};
+        std::size_t offset_ = 0;
+        std::uint64_t recorded_step_count_ = 0;
+
+    public:
+        //Samples the last step when the scene has run one since the previous call
+        void Record(const Stats& stats)
+        {
+            if (stats.step_count == recorded_step_count_)
+            {
+                return;
+            }
+            recorded_step_count_ = stats.step_count;
+
+            for (std::size_t i = 0; i < kPhaseCount; ++i)
+            {
+                phase_microseconds_[i][offset_] = stats.last_step.phase_microseconds[i];
+            }
+            step_microseconds_[offset_] = stats.last_step.StepMicroseconds();
+            offset_ = (offset_ + 1) % kStatsHistoryLength;
+        }
+
+        void Clear() { *this = StatsHistory(); }
+
+        [[nodiscard]] std::span<const float> phase_microseconds(const Phase phase) const
+        {
+            return phase_microseconds_[static_cast<std::size_t>(phase)];
+        }
+        [[nodiscard]] std::span<const float> step_microseconds() const { return step_microseconds_; }
+        [[nodiscard]] std::size_t offset() const { return offset_; }
+    };
+
+    //Adds the time between its construction and its destruction to a phase of the stats
+    class ScopedPhaseTimer
+    {
+    private:
+        Stats& stats_;
+        Phase phase_;
+        std::chrono::steady_clock::time_point start_;
+
+    public:
+        ScopedPhaseTimer(Stats& stats, const Phase phase)
+            : stats_(stats), phase_(phase), start_(std::chrono::steady_clock::now())
+        {
+        }
+
+        ~ScopedPhaseTimer()
+        {
+            const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_).count();
+            stats_[phase_] += seconds;
+            stats_.step.phase_microseconds[static_cast<std::size_t>(phase_)] += static_cast<float>(seconds * 1e6);
+        }
+
+        ScopedPhaseTimer(const ScopedPhaseTimer&) = delete;
+        ScopedPhaseTimer& operator=(const ScopedPhaseTimer&) = delete;
+    };
+}
+
+#endif //KUMA_ENGINE_LIB_PHYSICS_STATS_H_
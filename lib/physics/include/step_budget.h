@@ -0,0 +1,107 @@
+#ifndef KUMA_ENGINE_LIB_PHYSICS_STEP_BUDGET_H_
+#define KUMA_ENGINE_LIB_PHYSICS_STEP_BUDGET_H_
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+#include "solver_settings.h"
+
+namespace physics
+{
+    static constexpr int kDefaultMaxStepsPerFrame = 4;
+    static constexpr int kMaxStepsPerFrame = 16;
+
+    //Fractions of the fixed step a step may cost before the adaptive mode lowers its work, and below which it gives it back
+    static constexpr float kAdaptiveHighLoad = 0.5f;
+    static constexpr float kAdaptiveLowLoad = 0.25f;
+    //Steps between two changes of the load reduction, so the average catches up with the previous change
+    static constexpr int kAdaptiveInterval = 30;
+
+    //Keeps a fixed step loop from falling further and further behind when its steps cost more than the time they simulate
+    //A frame runs at most max_steps_per_frame steps, the time above that is dropped and counted, so the simulation slows down
+    //In adaptive mode the measured step time also lowers the solver work under load, through the load reduction of the settings
+    class StepBudget
+    {
+    private:
+        int max_steps_per_frame_ = kDefaultMaxStepsPerFrame;
+        bool adaptive_ = false;
+
+        double dropped_seconds_ = 0.0;
+        std::uint64_t dropped_steps_ = 0;
+
+        float average_step_seconds_ = 0.0f;
+        int steps_since_change_ = 0;
+
+    public:
+        //Number of steps the accumulated time pays for, their time is taken from the accumulator
+        //Above the cap whole steps are dropped, the remainder is kept for the interpolation
+        [[nodiscard]] int TakeSteps(float& accumulator, const float fixed_time_step)
+        {
+            int step_count = static_cast<int>(accumulator / fixed_time_step);
+            if (step_count > max_steps_per_frame_)
+            {
+                Drop(static_cast<double>(step_count - max_steps_per_frame_) * fixed_time_step, fixed_time_step);
+                step_count = max_steps_per_frame_;
+            }
+            accumulator = std::fmod(accumulator, fixed_time_step);
+            return step_count;
+        }
+
+        //Counts time the simulation did not cover, for loops that pace themselves instead of calling TakeSteps
+        void Drop(const double seconds, const float fixed_time_step)
+        {
+            dropped_seconds_ += seconds;
+            dropped_steps_ += static_cast<std::uint64_t>(seconds / fixed_time_step);
+        }
+
+        //Called after each step with its measured cost, moves the load reduction when adaptive
+        //Deterministic scenes keep their full work, a reduction driven by the clock would change their results
+        void UpdateSolver(SolverSettings& settings, const float step_seconds, const float fixed_time_step)
+        {
+            if (!adaptive_ || settings.deterministic)
+            {
+                settings.load_reduction = 0;
+                return;
+            }
+
+            average_step_seconds_ += (step_seconds - average_step_seconds_) * 0.1f;
+            steps_since_change_ = std::min(steps_since_change_ + 1, kAdaptiveInterval);
+            if (steps_since_change_ < kAdaptiveInterval)
+            {
+                return;
+            }
+
+            const int reduction = settings.load_reduction;
+            if (average_step_seconds_ > kAdaptiveHighLoad * fixed_time_step)
+            {
+                settings.load_reduction = std::min(reduction + 1, settings.MaxLoadReduction());
+            }
+            else if (average_step_seconds_ < kAdaptiveLowLoad * fixed_time_step)
+            {
+                settings.load_reduction = std::max(reduction - 1, 0);
+            }
+            if (settings.load_reduction != reduction)
+            {
+                steps_since_change_ = 0;
+            }
+        }
+
+        void ResetDropped()
+        {
+            dropped_seconds_ = 0.0;
+            dropped_steps_ = 0;
+        }
+
+        [[nodiscard]] int max_steps_per_frame() const { return max_steps_per_frame_; }
+        [[nodiscard]] bool adaptive() const { return adaptive_; }
+        [[nodiscard]] double dropped_seconds() const { return dropped_seconds_; }
+        [[nodiscard]] std::uint64_t dropped_steps() const { return dropped_steps_; }
+        [[nodiscard]] float average_step_seconds() const { return average_step_seconds_; }
+
+        void set_max_steps_per_frame(const int max_steps) { max_steps_per_frame_ = std::clamp(max_steps, 1, kMaxStepsPerFrame); }
+        void set_adaptive(const bool adaptive) { adaptive_ = adaptive; }
+    };
+}
+
+#endif //KUMA_ENGINE_LIB_PHYSICS_STEP_BUDGET_H_
@@ -0,0 +1,122 @@
+#ifndef KUMA_ENGINE_LIB_PHYSICS_TIME_OF_IMPACT_H_
+#define KUMA_ENGINE_LIB_PHYSICS_TIME_OF_IMPACT_H_
+
+#include <cmath>
+#include <limits>
+#include <variant>
+
+#include "collider.h"
+#include "shape.h"
+#include "vec2.h"
+
+namespace physics
+{
+    static constexpr int kMaxAdvancementIterations = 20;
+    static constexpr float kTimeOfImpactTolerance = 0.05f;
+
+    //Furthest any point of the shape moves per radian it turns, zero for the shapes that ignore rotation
+    template <typename Shape>
+    [[nodiscard]] float RotationRadius(const Shape& shape)
+    {
+        if constexpr (requires { shape.BoundingRadius(); })
+        {
+            return shape.BoundingRadius();
+        }
+        else
+        {
+            return 0.0f;
+        }
+    }
+
+    template <typename Shape>
+    [[nodiscard]] float ShapeRotation(const Shape& shape)
+    {
+        if constexpr (requires { shape.rotation(); })
+        {
+            return shape.rotation();
+        }
+        else
+        {
+            return 0.0f;
+        }
+    }
+
+    template <typename Shape>
+    void MoveShape(Shape& shape, const math::Vec2f position, const float rotation)
+    {
+        if constexpr (requires { shape.set_transform(position, rotation); })
+        {
+            shape.set_transform(position, rotation);
+        }
+        else
+        {
+            shape.UpdatePosition(position);
+        }
+    }
+
+    //Conservative advancement for two shapes moving from their start to their end position
+    //The shapes are given at the end of the motion, rotation_a and rotation_b are the angles they turned through to get there
+    //Returns true and the fraction of the motion at which they touch if they meet during it,
+    //false when they never come within the tolerance in the allowed iterations
+    template <typename ShapeA, typename ShapeB>
+    [[nodiscard]] bool ConservativeAdvancement(ShapeA shape_a, const math::Vec2f start_a, const math::Vec2f end_a,
+                                               ShapeB shape_b, const math::Vec2f start_b, const math::Vec2f end_b,
+                                               float& time_of_impact,
+                                               const float rotation_a = 0.0f, const float rotation_b = 0.0f)
+    {
+        const math::Vec2f motion_a = end_a - start_a;
+        const math::Vec2f motion_b = end_b - start_b;
+        const float end_rotation_a = ShapeRotation(shape_a);
+        const float end_rotation_b = ShapeRotation(shape_b);
+
+        //No point of either shape closes in faster than the relative displacement plus the arcs its furthest points turn through
+        const float relative_motion = (motion_a - motion_b).Magnitude() +
+            std::abs(rotation_a) * RotationRadius(shape_a) + std::abs(rotation_b) * RotationRadius(shape_b);
+        if (relative_motion <= std::numeric_limits<float>::epsilon()) { return false; }
+
+        float t = 0.0f;
+        for (int i = 0; i < kMaxAdvancementIterations; ++i)
+        {
+            MoveShape(shape_a, start_a + motion_a * t, end_rotation_a - rotation_a * (1.0f - t));
+            MoveShape(shape_b, start_b + motion_b * t, end_rotation_b - rotation_b * (1.0f - t));
+
+            const float distance = math::Distance(shape_a, shape_b);
+            if (distance <= kTimeOfImpactTolerance)
+            {
+                //Already overlapping at the start of the motion, the discrete narrow phase handles it
+                if (i == 0) { return false; }
+
+                time_of_impact = t;
+                return true;
+            }
+
+            t += distance / relative_motion;
+            if (t >= 1.0f) { return false; }
+        }
+
+        //Out of iterations before the shapes got within the tolerance, a slow graze rather than an impact
+        return false;
+    }
+
+    //Time of impact between two colliders, for the shape pairs that support it (circles and AABBs)
+    [[nodiscard]] inline bool TimeOfImpact(const Collider& collider_a, const math::Vec2f start_a, const math::Vec2f end_a,
+                                           const Collider& collider_b, const math::Vec2f start_b, const math::Vec2f end_b,
+                                           float& time_of_impact,
+                                           const float rotation_a = 0.0f, const float rotation_b = 0.0f)
+    {
+        return VisitShapes(collider_a, collider_b, [&](const auto& shape_a, const auto& shape_b)
+        {
+            if constexpr (requires { math::Distance(shape_a, shape_b); })
+            {
+                return ConservativeAdvancement(shape_a, start_a, end_a, shape_b, start_b, end_b, time_of_impact,
+                                               rotation_a, rotation_b);
+            }
+            else
+            {
+                return false;
+            }
+        });
+    }
+}
+
+#endif //KUMA_ENGINE_LIB_PHYSICS_TIME_OF_IMPACT_H_
@@ -0,0 +1,88 @@
+#include <gtest/gtest.h>
+
+#include "body.h"
+
+TEST(BodyAngular, FixedRotationByDefault)
+{
+    physics::Body body(physics::BodyType::Dynamic, math::Vec2f::Zero(), math::Vec2f(1.0f, 0.0f), 2.0f);
+    EXPECT_TRUE(body.has_fixed_rotation());
+
+    body.ApplyTorque(10.0f);
+    body.ApplyImpulse(math::Vec2f(0.0f, 1.0f), math::Vec2f(1.0f, 0.0f));
+    body.Update(1.0f);
+
+    EXPECT_FLOAT_EQ(body.angular_velocity(), 0.0f);
+    EXPECT_FLOAT_EQ(body.orientation(), 0.0f);
+}
+
+TEST(BodyAngular, TorqueIntegration)
+{
+    physics::Body body(physics::BodyType::Dynamic, math::Vec2f::Zero(), math::Vec2f::Zero(), 2.0f);
+    body.set_inertia(4.0f);
+    EXPECT_FALSE(body.has_fixed_rotation());
+
+    body.ApplyTorque(8.0f);
+    body.Update(0.5f);
+
+    EXPECT_FLOAT_EQ(body.angular_velocity(), 1.0f);
+    EXPECT_FLOAT_EQ(body.orientation(), 0.5f);
+    EXPECT_FLOAT_EQ(body.torque(), 0.0f);
+}
+
+TEST(BodyAngular, OffCentreImpulse)
+{
+    physics::Body body(physics::BodyType::Dynamic, math::Vec2f::Zero(), math::Vec2f::Zero(), 2.0f);
+    body.set_inertia(0.5f);
+
+    //Pushing up on the right side spins the body counter-clockwise
+    body.ApplyImpulse(math::Vec2f(0.0f, 1.0f), math::Vec2f(1.0f, 0.0f));
+
+    EXPECT_FLOAT_EQ(body.velocity().y, 0.5f);
+    EXPECT_FLOAT_EQ(body.angular_velocity(), 2.0f);
+}
+
+TEST(BodyAngular, StaticBodiesDoNotRotate)
+{
+    physics::Body body(physics::BodyType::Static, math::Vec2f::Zero(), math::Vec2f::Zero(), 0.0f);
+    body.set_inertia(3.0f);
+    EXPECT_TRUE(body.has_fixed_rotation());
+}
+
+TEST(BodySplitImpulse, PseudoVelocityOnlyMovesPosition)
+{
+    physics::Body body(physics::BodyType::Dynamic, math::Vec2f::Zero(), math::Vec2f(1.0f, 0.0f), 2.0f);
+
+    body.ApplyPseudoImpulse(math::Vec2f(0.0f, 4.0f), math::Vec2f::Zero());
+    EXPECT_FLOAT_EQ(body.pseudo_velocity().y, 2.0f);
+    EXPECT_FLOAT_EQ(body.velocity().y, 0.0f);
+
+    //The pseudo-velocity is consumed by the integration and does not carry over
+    body.IntegratePseudoVelocity(0.5f);
+    EXPECT_FLOAT_EQ(body.position().y, 1.0f);
+    EXPECT_FLOAT_EQ(body.pseudo_velocity().y, 0.0f);
+    EXPECT_FLOAT_EQ(body.velocity().x, 1.0f);
+}
+
+TEST(BodySplitImpulse, StaticBodiesIgnorePseudoImpulses)
+{
+    physics::Body body(physics::BodyType::Static, math::Vec2f::Zero(), math::Vec2f::Zero(), 0.0f);
+    body.ApplyPseudoImpulse(math::Vec2f(0.0f, 4.0f), math::Vec2f(1.0f, 0.0f));
+    body.IntegratePseudoVelocity(1.0f);
+    EXPECT_FLOAT_EQ(body.position().y, 0.0f);
+}
+
+//A step made of several updates interpolates from the start of the whole step
+TEST(Body, InterpolatesFromStepStart)
+{
+    physics::Body body(physics::BodyType::Dynamic, math::Vec2f::Zero(), math::Vec2f(4.0f, 0.0f), 2.0f);
+    body.set_angular_velocity(2.0f);
+
+    body.SaveStepStart();
+    body.Update(0.5f);
+    body.Update(0.5f);
+
+    EXPECT_FLOAT_EQ(body.InterpolatedPosition(0.0f).x, 0.0f);
+    EXPECT_FLOAT_EQ(body.InterpolatedPosition(0.25f).x, 1.0f);
+    EXPECT_FLOAT_EQ(body.InterpolatedPosition(1.0f).x, body.position().x);
+    EXPECT_FLOAT_EQ(body.InterpolatedOrientation(0.5f), 1.0f);
+}
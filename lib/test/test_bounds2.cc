@@ -0,0 +1,47 @@
+#include <gtest/gtest.h>
+
+#include "bounds2.h"
+#include "shape.h"
+
+TEST(Bounds2, Layout)
+{
+    static_assert(sizeof(math::Bounds2f) == 16);
+
+    const math::Bounds2f bounds(math::Vec2f(1.0f, 2.0f), math::Vec2f(5.0f, 4.0f));
+    EXPECT_FLOAT_EQ(bounds.Centre().x, 3.0f);
+    EXPECT_FLOAT_EQ(bounds.Centre().y, 3.0f);
+    EXPECT_FLOAT_EQ(bounds.HalfSize().x, 2.0f);
+    EXPECT_FLOAT_EQ(bounds.HalfSize().y, 1.0f);
+}
+
+TEST(Bounds2, ContainsAndIntersect)
+{
+    const math::Bounds2f outer(math::Vec2f(0.0f, 0.0f), math::Vec2f(10.0f, 10.0f));
+    const math::Bounds2f inner(math::Vec2f(2.0f, 2.0f), math::Vec2f(4.0f, 4.0f));
+    const math::Bounds2f crossing(math::Vec2f(8.0f, 8.0f), math::Vec2f(12.0f, 12.0f));
+    const math::Bounds2f apart(math::Vec2f(11.0f, 0.0f), math::Vec2f(12.0f, 1.0f));
+
+    EXPECT_TRUE(outer.Contains(inner));
+    EXPECT_FALSE(outer.Contains(crossing));
+    EXPECT_TRUE(math::Intersect(outer, crossing));
+    EXPECT_FALSE(math::Intersect(outer, apart));
+}
+
+TEST(Bounds2, Swept)
+{
+    const math::Bounds2f bounds(math::Vec2f(0.0f, 0.0f), math::Vec2f(1.0f, 1.0f));
+    const math::Bounds2f swept = bounds.Swept(math::Vec2f(3.0f, -2.0f));
+
+    EXPECT_EQ(swept, math::Bounds2f(math::Vec2f(0.0f, -2.0f), math::Vec2f(4.0f, 1.0f)));
+}
+
+//The shapes give the same corners as their full bounding boxes
+TEST(Bounds2, MatchesShapeBoundingBoxes)
+{
+    const math::Circle circle(math::Vec2f(3.0f, 4.0f), 2.0f);
+    EXPECT_EQ(circle.GetBounds(), math::Bounds2f(circle.GetBoundingBox().min_bound(), circle.GetBoundingBox().max_bound()));
+
+    const math::Polygon triangle({math::Vec2f(0.0f, 0.0f), math::Vec2f(3.0f, 0.0f), math::Vec2f(0.0f, 3.0f)});
+    EXPECT_NEAR(triangle.GetBounds().max_bound().x, 3.0f, 1e-5f);
+    EXPECT_NEAR(triangle.GetBounds().min_bound().y, 0.0f, 1e-5f);
+}
@@ -0,0 +1,61 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <type_traits>
+
+#include "collider.h"
+
+//The typed accessors read the shape in place, set_shape switches the tag
+TEST(Collider, TypedShapeAccess)
+{
+    static_assert(std::is_trivially_copyable_v<physics::Collider>);
+
+    physics::Collider collider(math::Circle(math::Vec2f(1.0f, 2.0f), 3.0f), 0.5f, 0.2f, false);
+    EXPECT_EQ(collider.GetShapeType(), math::ShapeType::kCircle);
+    EXPECT_FLOAT_EQ(collider.circle().radius(), 3.0f);
+
+    collider.set_shape(math::AABB(math::Vec2f(0.0f, 0.0f), math::Vec2f(2.0f, 4.0f)));
+    EXPECT_EQ(collider.GetShapeType(), math::ShapeType::kAABB);
+    EXPECT_FLOAT_EQ(collider.aabb().max_bound().y, 4.0f);
+    EXPECT_FLOAT_EQ(collider.GetBoundingBox().max_bound().x, 2.0f);
+
+    collider.set_shape(math::Polygon({math::Vec2f(0.0f, 0.0f), math::Vec2f(3.0f, 0.0f), math::Vec2f(0.0f, 3.0f)}));
+    EXPECT_EQ(collider.GetShapeType(), math::ShapeType::kPolygon);
+    EXPECT_EQ(collider.polygon().VertexCount(), 3u);
+}
+
+TEST(Collider, VisitShapes)
+{
+    const physics::Collider circle(math::Circle(math::Vec2f(0.0f, 0.0f), 1.0f), 0.0f, 0.0f, false);
+    const physics::Collider near_box(math::AABB(math::Vec2f(0.5f, -1.0f), math::Vec2f(2.0f, 1.0f)), 0.0f, 0.0f, false);
+    const physics::Collider far_box(math::AABB(math::Vec2f(5.0f, -1.0f), math::Vec2f(6.0f, 1.0f)), 0.0f, 0.0f, false);
+
+    const auto intersect = [](const auto& shape_a, const auto& shape_b) { return math::Intersect(shape_a, shape_b); };
+    EXPECT_TRUE(physics::VisitShapes(circle, near_box, intersect));
+    EXPECT_TRUE(physics::VisitShapes(near_box, circle, intersect));
+    EXPECT_FALSE(physics::VisitShapes(circle, far_box, intersect));
+}
+
+TEST(Collider, CollisionFilter)
+{
+    constexpr std::uint16_t kDebris = 0x0002;
+    constexpr std::uint16_t kPlayer = 0x0004;
+
+    physics::Collider debris(math::Circle(1.0f), 0.0f, 0.0f, false);
+    debris.set_filter({kDebris, static_cast<std::uint16_t>(0xFFFF & ~kDebris)});
+    physics::Collider other_debris = debris;
+    physics::Collider player(math::Circle(1.0f), 0.0f, 0.0f, false);
+    player.set_filter({kPlayer, 0xFFFF});
+    const physics::Collider wall(math::Circle(1.0f), 0.0f, 0.0f, false);
+
+    //Debris ignores other debris but still meets the player and the default layer
+    EXPECT_FALSE(debris.ShouldCollide(other_debris));
+    EXPECT_TRUE(debris.ShouldCollide(player));
+    EXPECT_TRUE(player.ShouldCollide(debris));
+    EXPECT_TRUE(debris.ShouldCollide(wall));
+
+    //Both masks must agree
+    player.set_filter({kPlayer, 0x0001});
+    EXPECT_FALSE(debris.ShouldCollide(player));
+    EXPECT_FALSE(player.ShouldCollide(debris));
+}
@@ -0,0 +1,17 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+
+#include "common.h"
+
+TEST(Common, ConstexprSinCos)
+{
+    static_assert(common::Sin(0.0f) == 0.0f);
+    static_assert(common::Cos(0.0f) > 0.999999f);
+
+    for (float angle = -10.0f; angle <= 10.0f; angle += 0.01f)
+    {
+        EXPECT_NEAR(common::Sin(angle), std::sin(angle), 1e-6f);
+        EXPECT_NEAR(common::Cos(angle), std::cos(angle), 1e-6f);
+    }
+}
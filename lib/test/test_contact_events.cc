@@ -0,0 +1,39 @@
+#include <gtest/gtest.h>
+
+#include "contact_events.h"
+
+TEST(ContactEventQueue, DrainKeepsOrderAndEmpties)
+{
+    physics::ContactEventQueue<int> queue(4);
+    queue.Push({1, 2, math::Vec2f(0.0f, 1.0f), 3.0f, physics::ContactEventKind::kBegin});
+    queue.Push({1, 2, math::Vec2f(0.0f, 1.0f), 2.0f, physics::ContactEventKind::kStay});
+    queue.Push({1, 2, math::Vec2f::Zero(), 0.0f, physics::ContactEventKind::kEnd});
+    ASSERT_EQ(queue.size(), 3u);
+
+    std::vector<physics::ContactEventKind> kinds;
+    float impulse = 0.0f;
+    queue.Drain([&](const physics::ContactEvent<int>& event)
+    {
+        kinds.push_back(event.kind);
+        impulse += event.impulse;
+    });
+
+    EXPECT_TRUE(queue.empty());
+    EXPECT_EQ(kinds, (std::vector{physics::ContactEventKind::kBegin, physics::ContactEventKind::kStay, physics::ContactEventKind::kEnd}));
+    EXPECT_FLOAT_EQ(impulse, 5.0f);
+}
+
+//Removed objects leave no event behind them
+TEST(ContactEventQueue, RemoveDropsHandleEvents)
+{
+    physics::ContactEventQueue<int> queue;
+    queue.Push({1, 2});
+    queue.Push({3, 1});
+    queue.Push({3, 4});
+
+    queue.Remove(1);
+
+    ASSERT_EQ(queue.size(), 1u);
+    EXPECT_EQ(queue.events()[0].handle_a, 3);
+    EXPECT_EQ(queue.events()[0].handle_b, 4);
+}
@@ -0,0 +1,86 @@
+#include <gtest/gtest.h>
+
+#include "four_intersect.h"
+#include "shape.h"
+
+//Every lane gives the same answer as the scalar test
+TEST(FourIntersect, CirclesMatchScalar)
+{
+    const std::array<math::Circle, 4> circles_a = {
+        math::Circle(math::Vec2f(0.0f, 0.0f), 1.0f), math::Circle(math::Vec2f(0.0f, 0.0f), 1.0f),
+        math::Circle(math::Vec2f(5.0f, 5.0f), 2.0f), math::Circle(math::Vec2f(-3.0f, 1.0f), 0.5f)};
+    const std::array<math::Circle, 4> circles_b = {
+        math::Circle(math::Vec2f(1.5f, 0.0f), 1.0f), math::Circle(math::Vec2f(2.0f, 0.0f), 1.0f),
+        math::Circle(math::Vec2f(9.0f, 5.0f), 1.0f), math::Circle(math::Vec2f(-3.0f, 1.2f), 0.1f)};
+
+    math::FourVec2f centres_a, centres_b;
+    std::array<float, 4> radii_a{}, radii_b{};
+    int expected = 0;
+    for (int i = 0; i < 4; ++i)
+    {
+        centres_a.x[i] = circles_a[i].centre().x;
+        centres_a.y[i] = circles_a[i].centre().y;
+        centres_b.x[i] = circles_b[i].centre().x;
+        centres_b.y[i] = circles_b[i].centre().y;
+        radii_a[i] = circles_a[i].radius();
+        radii_b[i] = circles_b[i].radius();
+        if (math::Intersect(circles_a[i], circles_b[i])) { expected |= 1 << i; }
+    }
+
+    EXPECT_EQ(expected, 0b1001);
+    EXPECT_EQ(math::IntersectFourCircles(centres_a, radii_a, centres_b, radii_b), expected);
+}
+
+TEST(FourIntersect, AABBsMatchScalar)
+{
+    const std::array<math::AABB, 4> boxes_a = {
+        math::AABB(math::Vec2f(0.0f, 0.0f), math::Vec2f(2.0f, 2.0f)), math::AABB(math::Vec2f(0.0f, 0.0f), math::Vec2f(2.0f, 2.0f)),
+        math::AABB(math::Vec2f(0.0f, 0.0f), math::Vec2f(2.0f, 2.0f)), math::AABB(math::Vec2f(0.0f, 0.0f), math::Vec2f(2.0f, 2.0f))};
+    const std::array<math::AABB, 4> boxes_b = {
+        math::AABB(math::Vec2f(1.0f, 1.0f), math::Vec2f(3.0f, 3.0f)), math::AABB(math::Vec2f(2.0f, 0.0f), math::Vec2f(4.0f, 2.0f)),
+        math::AABB(math::Vec2f(0.0f, 3.0f), math::Vec2f(2.0f, 4.0f)), math::AABB(math::Vec2f(-5.0f, 1.0f), math::Vec2f(-1.0f, 1.5f))};
+
+    math::FourVec2f min_a, max_a, min_b, max_b;
+    int expected = 0;
+    for (int i = 0; i < 4; ++i)
+    {
+        min_a.x[i] = boxes_a[i].min_bound().x;
+        min_a.y[i] = boxes_a[i].min_bound().y;
+        max_a.x[i] = boxes_a[i].max_bound().x;
+        max_a.y[i] = boxes_a[i].max_bound().y;
+        min_b.x[i] = boxes_b[i].min_bound().x;
+        min_b.y[i] = boxes_b[i].min_bound().y;
+        max_b.x[i] = boxes_b[i].max_bound().x;
+        max_b.y[i] = boxes_b[i].max_bound().y;
+        if (math::Intersect(boxes_a[i], boxes_b[i])) { expected |= 1 << i; }
+    }
+
+    EXPECT_EQ(expected, 0b0011);
+    EXPECT_EQ(math::IntersectFourAABBs(min_a, max_a, min_b, max_b), expected);
+}
+
+TEST(FourIntersect, AABBCirclesMatchScalar)
+{
+    const math::AABB box(math::Vec2f(0.0f, 0.0f), math::Vec2f(2.0f, 2.0f));
+    const std::array<math::Circle, 4> circles = {
+        math::Circle(math::Vec2f(1.0f, 1.0f), 0.5f), math::Circle(math::Vec2f(3.0f, 1.0f), 0.5f),
+        math::Circle(math::Vec2f(2.5f, 2.5f), 1.0f), math::Circle(math::Vec2f(3.0f, 3.0f), 1.0f)};
+
+    math::FourVec2f min, max, centres;
+    std::array<float, 4> radii{};
+    int expected = 0;
+    for (int i = 0; i < 4; ++i)
+    {
+        min.x[i] = box.min_bound().x;
+        min.y[i] = box.min_bound().y;
+        max.x[i] = box.max_bound().x;
+        max.y[i] = box.max_bound().y;
+        centres.x[i] = circles[i].centre().x;
+        centres.y[i] = circles[i].centre().y;
+        radii[i] = circles[i].radius();
+        if (math::Intersect(box, circles[i])) { expected |= 1 << i; }
+    }
+
+    EXPECT_EQ(expected, 0b0101);
+    EXPECT_EQ(math::IntersectFourAABBCircles(min, max, centres, radii), expected);
+}
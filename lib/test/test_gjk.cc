@@ -0,0 +1,88 @@
+#include <gtest/gtest.h>
+
+#include "gjk.h"
+#include "shape.h"
+
+namespace
+{
+    math::Polygon Square(const math::Vec2f centre, const float half_size)
+    {
+        return math::Polygon({
+            centre + math::Vec2f(-half_size, -half_size),
+            centre + math::Vec2f(half_size, -half_size),
+            centre + math::Vec2f(half_size, half_size),
+            centre + math::Vec2f(-half_size, half_size)});
+    }
+}
+
+TEST(Gjk, PolygonIntersection)
+{
+    const auto square = Square(math::Vec2f::Zero(), 1.0f);
+    const math::Polygon triangle({math::Vec2f(0.5f, 0.5f), math::Vec2f(3.0f, 0.5f), math::Vec2f(0.5f, 3.0f)});
+    const auto far_square = Square(math::Vec2f(5.0f, 0.0f), 1.0f);
+
+    EXPECT_TRUE(math::Intersect(square, triangle));
+    EXPECT_TRUE(math::Intersect(triangle, square));
+    EXPECT_FALSE(math::Intersect(square, far_square));
+}
+
+TEST(Gjk, ShapesAgainstPolygons)
+{
+    const auto square = Square(math::Vec2f::Zero(), 1.0f);
+
+    EXPECT_TRUE(math::Intersect(math::AABB(math::Vec2f(0.5f, 0.5f), math::Vec2f(2.0f, 2.0f)), square));
+    EXPECT_FALSE(math::Intersect(math::AABB(math::Vec2f(1.5f, 1.5f), math::Vec2f(2.0f, 2.0f)), square));
+
+    //Near a corner, the circle only touches when its radius reaches the corner
+    EXPECT_TRUE(math::Intersect(math::Circle(math::Vec2f(2.0f, 2.0f), 1.5f), square));
+    EXPECT_FALSE(math::Intersect(math::Circle(math::Vec2f(2.0f, 2.0f), 1.3f), square));
+    EXPECT_TRUE(math::Intersect(math::Circle(math::Vec2f(0.2f, 0.1f), 0.1f), square));
+}
+
+TEST(Gjk, Distance)
+{
+    const auto square_a = Square(math::Vec2f::Zero(), 1.0f);
+    const auto square_b = Square(math::Vec2f(4.0f, 0.5f), 1.0f);
+
+    math::Simplex simplex;
+    math::Vec2f closest = math::Vec2f::Zero();
+    const float distance = math::GjkDistance(math::SupportFunction(square_a), math::SupportFunction(square_b), simplex, closest);
+
+    EXPECT_NEAR(distance, 2.0f, 1e-4f);
+    //The closest point points from B to A
+    EXPECT_NEAR(closest.x, -2.0f, 1e-4f);
+    EXPECT_NEAR(closest.y, 0.0f, 1e-4f);
+
+    const auto overlapping = Square(math::Vec2f(1.0f, 0.0f), 1.0f);
+    EXPECT_FLOAT_EQ(math::GjkDistance(math::SupportFunction(square_a), math::SupportFunction(overlapping), simplex, closest), 0.0f);
+}
+
+TEST(Gjk, EpaPenetration)
+{
+    const auto square_a = Square(math::Vec2f(0.0f, 1.5f), 1.0f);
+    const auto square_b = Square(math::Vec2f(0.2f, 0.0f), 1.0f);
+    const auto support_a = math::SupportFunction(square_a);
+    const auto support_b = math::SupportFunction(square_b);
+
+    math::Simplex simplex;
+    ASSERT_TRUE(math::GjkIntersect(support_a, support_b, simplex));
+    const math::Penetration penetration = math::Epa(support_a, support_b, simplex);
+
+    //A sits 0.5 deep on top of B, so it is pushed up
+    EXPECT_NEAR(penetration.depth, 0.5f, 1e-3f);
+    EXPECT_NEAR(penetration.normal.x, 0.0f, 1e-3f);
+    EXPECT_NEAR(penetration.normal.y, 1.0f, 1e-3f);
+}
+
+TEST(Gjk, EpaTouchingShapes)
+{
+    const auto square_a = Square(math::Vec2f(2.0f, 0.0f), 1.0f);
+    const auto square_b = Square(math::Vec2f::Zero(), 1.0f);
+    const auto support_a = math::SupportFunction(square_a);
+    const auto support_b = math::SupportFunction(square_b);
+
+    math::Simplex simplex;
+    ASSERT_TRUE(math::GjkIntersect(support_a, support_b, simplex));
+    const math::Penetration penetration = math::Epa(support_a, support_b, simplex);
+    EXPECT_NEAR(penetration.depth, 0.0f, 1e-3f);
+}
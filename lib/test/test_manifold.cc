@@ -0,0 +1,144 @@
+#include <gtest/gtest.h>
+
+#include "manifold.h"
+
+namespace
+{
+    math::Polygon Box(const math::Vec2f centre, const math::Vec2f half_size)
+    {
+        return math::Polygon({
+            centre + math::Vec2f(-half_size.x, -half_size.y),
+            centre + math::Vec2f(half_size.x, -half_size.y),
+            centre + math::Vec2f(half_size.x, half_size.y),
+            centre + math::Vec2f(-half_size.x, half_size.y)});
+    }
+}
+
+TEST(PolygonNormals, OutwardForBothWindings)
+{
+    const auto counter_clockwise = Box(math::Vec2f::Zero(), math::Vec2f(1.0f, 1.0f));
+    const math::Polygon clockwise({
+        math::Vec2f(-1.0f, -1.0f), math::Vec2f(-1.0f, 1.0f), math::Vec2f(1.0f, 1.0f), math::Vec2f(1.0f, -1.0f)});
+
+    for (const auto* polygon : {&counter_clockwise, &clockwise})
+    {
+        ASSERT_EQ(polygon->normals().size(), 4u);
+        for (size_t i = 0; i < 4; ++i)
+        {
+            //The middle of each edge lies in the direction of its outward normal
+            const math::Vec2f middle = (polygon->vertices()[i] + polygon->vertices()[(i + 1) % 4]) * 0.5f;
+            EXPECT_NEAR(polygon->normals()[i].Dot(middle), 1.0f, 1e-5f);
+        }
+    }
+}
+
+TEST(Manifold, RestingBoxHasTwoPoints)
+{
+    const auto top = Box(math::Vec2f(0.0f, 1.9f), math::Vec2f(1.0f, 1.0f));
+    const auto ground = Box(math::Vec2f::Zero(), math::Vec2f(4.0f, 1.0f));
+
+    math::SatCache cache;
+    ASSERT_TRUE(math::Intersect(top, ground, cache));
+    const math::Manifold manifold = math::CollidePolygons(top, ground, cache);
+
+    ASSERT_EQ(manifold.point_count, 2);
+    EXPECT_NEAR(manifold.normal.x, 0.0f, 1e-5f);
+    EXPECT_NEAR(manifold.normal.y, 1.0f, 1e-5f);
+    for (int i = 0; i < manifold.point_count; ++i)
+    {
+        EXPECT_NEAR(manifold.penetrations[i], 0.1f, 1e-5f);
+        EXPECT_NEAR(std::abs(manifold.points[i].x), 1.0f, 1e-5f);
+    }
+
+    //The reference face is cached for the next step
+    EXPECT_NEAR(std::abs(cache.axis.y), 1.0f, 1e-5f);
+}
+
+TEST(Manifold, CachedSeparatingAxis)
+{
+    const auto left = Box(math::Vec2f::Zero(), math::Vec2f(1.0f, 1.0f));
+    const auto right = Box(math::Vec2f(3.0f, 0.0f), math::Vec2f(1.0f, 1.0f));
+
+    math::SatCache cache;
+    EXPECT_FALSE(math::Intersect(left, right, cache));
+    EXPECT_NEAR(std::abs(cache.axis.x), 1.0f, 1e-5f);
+
+    //The cached axis keeps working whatever the order of the pair
+    EXPECT_FALSE(math::Intersect(right, left, cache));
+    EXPECT_EQ(math::CollidePolygons(right, left, cache).point_count, 0);
+}
+
+TEST(Manifold, CornerContact)
+{
+    //Diamond resting on its corner over a box
+    const math::Polygon diamond({
+        math::Vec2f(0.0f, 0.9f), math::Vec2f(1.0f, 1.9f), math::Vec2f(0.0f, 2.9f), math::Vec2f(-1.0f, 1.9f)});
+    const auto ground = Box(math::Vec2f::Zero(), math::Vec2f(4.0f, 1.0f));
+
+    math::SatCache cache;
+    const math::Manifold manifold = math::CollidePolygons(diamond, ground, cache);
+
+    ASSERT_EQ(manifold.point_count, 1);
+    EXPECT_NEAR(manifold.penetrations[0], 0.1f, 1e-5f);
+    EXPECT_NEAR(manifold.normal.y, 1.0f, 1e-5f);
+}
+
+//The manifold built from the faces of the overlap test matches the one that runs its own test
+TEST(Manifold, ReusesIntersectQuery)
+{
+    const auto top = Box(math::Vec2f(0.3f, 1.9f), math::Vec2f(1.0f, 1.0f));
+    const auto ground = Box(math::Vec2f::Zero(), math::Vec2f(4.0f, 1.0f));
+
+    math::SatCache cache;
+    math::SatQuery query;
+    ASSERT_TRUE(math::Intersect(top, ground, cache, query));
+    EXPECT_NEAR(std::max(query.separation_a, query.separation_b), -0.1f, 1e-5f);
+    const math::Manifold reused = math::CollidePolygons(top, ground, cache, query);
+
+    math::SatCache fresh_cache;
+    const math::Manifold fresh = math::CollidePolygons(top, ground, fresh_cache);
+
+    ASSERT_EQ(reused.point_count, fresh.point_count);
+    EXPECT_EQ(reused.normal, fresh.normal);
+    for (int i = 0; i < reused.point_count; ++i)
+    {
+        EXPECT_EQ(reused.points[i], fresh.points[i]);
+        EXPECT_EQ(reused.penetrations[i], fresh.penetrations[i]);
+    }
+}
+
+//A touching pair keeps its reference face while its penetration stays within the tolerances, in either order
+TEST(Manifold, KeepsCachedReferenceFace)
+{
+    const auto ground = Box(math::Vec2f::Zero(), math::Vec2f(4.0f, 1.0f));
+    math::SatCache cache;
+    math::SatQuery query;
+    ASSERT_TRUE(math::Intersect(Box(math::Vec2f(0.0f, 1.9f), math::Vec2f(1.0f, 1.0f)), ground, cache, query));
+    EXPECT_FALSE(query.cached_face);
+    (void)math::CollidePolygons(Box(math::Vec2f(0.0f, 1.9f), math::Vec2f(1.0f, 1.0f)), ground, cache, query);
+    ASSERT_TRUE(cache.touching);
+
+    //Slid sideways and a little deeper, the cached face gives the same manifold as a full search
+    const auto top = Box(math::Vec2f(0.5f, 1.85f), math::Vec2f(1.0f, 1.0f));
+    ASSERT_TRUE(math::Intersect(ground, top, cache, query));
+    EXPECT_TRUE(query.cached_face);
+    const math::Manifold cached = math::CollidePolygons(ground, top, cache, query);
+
+    math::SatCache fresh_cache;
+    const math::Manifold fresh = math::CollidePolygons(ground, top, fresh_cache);
+    ASSERT_EQ(cached.point_count, 2);
+    ASSERT_EQ(cached.point_count, fresh.point_count);
+    EXPECT_EQ(cached.normal, fresh.normal);
+    for (int i = 0; i < cached.point_count; ++i)
+    {
+        EXPECT_NEAR(cached.penetrations[i], fresh.penetrations[i], 1e-5f);
+    }
+
+    //Much deeper than at the last full search, the faces are searched again
+    ASSERT_TRUE(math::Intersect(Box(math::Vec2f(0.0f, 1.5f), math::Vec2f(1.0f, 1.0f)), ground, cache, query));
+    EXPECT_FALSE(query.cached_face);
+
+    //Lifted off, the cached face separates the pair
+    EXPECT_FALSE(math::Intersect(Box(math::Vec2f(0.0f, 2.5f), math::Vec2f(1.0f, 1.0f)), ground, cache, query));
+    EXPECT_FALSE(cache.touching);
+}
@@ -0,0 +1,68 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <vector>
+
+#include "quadtree.h"
+
+namespace
+{
+    physics::Collider MakeCircle(const math::Vec2f centre, const physics::CollisionFilter filter = {})
+    {
+        physics::Collider collider(math::Circle(centre, 1.0f), 0.0f, 0.0f, false);
+        collider.set_filter(filter);
+        return collider;
+    }
+
+    bool Contains(const std::vector<physics::Collider*>& colliders, const physics::Collider& collider)
+    {
+        return std::ranges::find(colliders, &collider) != colliders.end();
+    }
+}
+
+TEST(Quadtree, QueryRange)
+{
+    physics::Quadtree quadtree(math::Bounds2f(math::Vec2f::Zero(), math::Vec2f(100.0f, 100.0f)));
+    std::vector<physics::Collider> colliders;
+    for (int i = 0; i < 20; ++i)
+    {
+        colliders.push_back(MakeCircle(math::Vec2f(5.0f + static_cast<float>(i) * 4.5f, 50.0f)));
+    }
+    for (auto& collider : colliders)
+    {
+        quadtree.Insert(&collider);
+    }
+
+    //Only the circles overlapping the left quarter are found, whichever node they went to
+    const auto found = quadtree.Query(math::Bounds2f(math::Vec2f(0.0f, 0.0f), math::Vec2f(25.0f, 100.0f)));
+    for (const auto& collider : colliders)
+    {
+        EXPECT_EQ(Contains(found, collider), collider.GetBoundingBox().min_bound().x <= 25.0f);
+    }
+}
+
+//A collider query skips the querier and the colliders its layers do not meet, on either side
+TEST(Quadtree, QueryFiltersLayers)
+{
+    constexpr physics::CollisionFilter kPlayer{0x0001, 0x0002 | 0x0004};
+    constexpr physics::CollisionFilter kWall{0x0002, 0xFFFF};
+    constexpr physics::CollisionFilter kPickup{0x0004, 0x0004}; //Only meets other pickups
+    constexpr physics::CollisionFilter kDecoration{0x0008, 0xFFFF}; //Not in the player mask
+
+    physics::Quadtree quadtree(math::Bounds2f(math::Vec2f::Zero(), math::Vec2f(100.0f, 100.0f)));
+    physics::Collider player = MakeCircle(math::Vec2f(50.0f, 50.0f), kPlayer);
+    physics::Collider wall = MakeCircle(math::Vec2f(51.0f, 50.0f), kWall);
+    physics::Collider pickup = MakeCircle(math::Vec2f(49.0f, 50.0f), kPickup);
+    physics::Collider decoration = MakeCircle(math::Vec2f(50.0f, 51.0f), kDecoration);
+    physics::Collider far_wall = MakeCircle(math::Vec2f(90.0f, 90.0f), kWall);
+    for (auto* collider : {&player, &wall, &pickup, &decoration, &far_wall})
+    {
+        quadtree.Insert(collider);
+    }
+
+    std::vector<physics::Collider*> found{&far_wall};
+    quadtree.Query(player, found);
+
+    EXPECT_EQ(found, std::vector<physics::Collider*>{&wall});
+    EXPECT_EQ(quadtree.Query(player), found);
+}
@@ -0,0 +1,68 @@
+#include <gtest/gtest.h>
+
+#include <array>
+#include <vector>
+
+#include "random.h"
+
+//Same seed, same sequence, so a scene can be replayed
+TEST(Random, SeedIsReproducible)
+{
+    common::rng::Engine engine_a(42);
+    common::rng::Engine engine_b(42);
+    common::rng::Engine engine_c(43);
+
+    bool differs = false;
+    for (int i = 0; i < 100; i++)
+    {
+        const auto value = engine_a();
+        EXPECT_EQ(value, engine_b());
+        differs |= value != engine_c();
+    }
+    EXPECT_TRUE(differs);
+
+    common::rng::Seed(7);
+    const float first = common::rng::Range(0.0f, 1.0f);
+    common::rng::Seed(7);
+    EXPECT_EQ(common::rng::Range(0.0f, 1.0f), first);
+}
+
+TEST(Random, RangeBounds)
+{
+    common::rng::Engine engine(1);
+    std::array<int, 6> counts{};
+    for (int i = 0; i < 6000; i++)
+    {
+        const int value = engine.Range(-2, 3);
+        ASSERT_GE(value, -2);
+        ASSERT_LE(value, 3);
+        counts[value + 2]++;
+    }
+    for (const int count : counts)
+    {
+        EXPECT_GT(count, 800);
+    }
+
+    for (int i = 0; i < 1000; i++)
+    {
+        const float value = engine.Range(5.0f, 10.0f);
+        ASSERT_GE(value, 5.0f);
+        ASSERT_LT(value, 10.0f);
+    }
+    EXPECT_FLOAT_EQ(engine.Range(1.0f, 1.0f), 1.0f);
+}
+
+//A batch gives the same numbers as the same count of single draws
+TEST(Random, FillMatchesRange)
+{
+    common::rng::Engine batch_engine(9);
+    common::rng::Engine single_engine(9);
+
+    std::vector<float> values(64);
+    batch_engine.Fill(std::span<float>(values), -50.0f, 50.0f);
+    for (const float value : values)
+    {
+        EXPECT_EQ(value, single_engine.Range(-50.0f, 50.0f));
+    }
+    EXPECT_EQ(batch_engine(), single_engine());
+}
@@ -0,0 +1,171 @@
+﻿#include <gtest/gtest.h>
+
+#include <numbers>
+#include <type_traits>
+
+#include "shape.h"
+
+TEST(ShapeInertia, Circle)
+{
+    const math::Circle circle(math::Vec2f(3.0f, 4.0f), 2.0f);
+    EXPECT_FLOAT_EQ(circle.CalculateInertia(10.0f), 0.5f * 10.0f * 4.0f);
+}
+
+TEST(ShapeInertia, AABB)
+{
+    const math::AABB aabb(math::Vec2f(0.0f, 0.0f), math::Vec2f(4.0f, 2.0f));
+    EXPECT_FLOAT_EQ(aabb.CalculateInertia(6.0f), 6.0f * (16.0f + 4.0f) / 12.0f);
+}
+
+//A rectangle polygon has the same inertia as the box, wherever it is and whatever its winding
+TEST(ShapeInertia, PolygonMatchesBox)
+{
+    const math::AABB aabb(math::Vec2f(10.0f, 20.0f), math::Vec2f(14.0f, 22.0f));
+    const math::Polygon counter_clockwise({
+        math::Vec2f(10.0f, 20.0f), math::Vec2f(14.0f, 20.0f), math::Vec2f(14.0f, 22.0f), math::Vec2f(10.0f, 22.0f)
+    });
+    const math::Polygon clockwise({
+        math::Vec2f(10.0f, 20.0f), math::Vec2f(10.0f, 22.0f), math::Vec2f(14.0f, 22.0f), math::Vec2f(14.0f, 20.0f)
+    });
+
+    EXPECT_NEAR(counter_clockwise.CalculateInertia(6.0f), aabb.CalculateInertia(6.0f), 1e-3f);
+    EXPECT_NEAR(clockwise.CalculateInertia(6.0f), aabb.CalculateInertia(6.0f), 1e-3f);
+}
+
+TEST(ShapeInertia, DegeneratePolygon)
+{
+    const math::Polygon segment({math::Vec2f(0.0f, 0.0f), math::Vec2f(1.0f, 0.0f)});
+    EXPECT_FLOAT_EQ(segment.CalculateInertia(1.0f), 0.0f);
+}
+
+TEST(PolygonSupport, EmptyPolygonIsAPoint)
+{
+    const math::Polygon empty(std::span<const math::Vec2f>{}, math::Vec2f(2.0f, 3.0f), 0.0f);
+    EXPECT_EQ(empty.Support(math::Vec2f(1.0f, 0.0f)), math::Vec2f(2.0f, 3.0f));
+}
+
+TEST(PolygonTransform, PlacedAtCentroid)
+{
+    const math::Polygon triangle({math::Vec2f(0.0f, 0.0f), math::Vec2f(3.0f, 0.0f), math::Vec2f(0.0f, 3.0f)});
+    EXPECT_NEAR(triangle.position().x, 1.0f, 1e-5f);
+    EXPECT_NEAR(triangle.position().y, 1.0f, 1e-5f);
+    EXPECT_NEAR(triangle.vertices()[1].x, 3.0f, 1e-5f);
+    EXPECT_NEAR(triangle.vertices()[1].y, 0.0f, 1e-5f);
+}
+
+TEST(PolygonTransform, MoveAndRotate)
+{
+    math::Polygon square({math::Vec2f(-1.0f, -1.0f), math::Vec2f(1.0f, -1.0f), math::Vec2f(1.0f, 1.0f), math::Vec2f(-1.0f, 1.0f)},
+                         math::Vec2f::Zero(), 0.0f);
+
+    //Moving shifts the cached bounds and the world vertices
+    square.UpdatePosition(math::Vec2f(5.0f, 2.0f));
+    EXPECT_FLOAT_EQ(square.GetBoundingBox().min_bound().x, 4.0f);
+    EXPECT_FLOAT_EQ(square.GetBoundingBox().max_bound().y, 3.0f);
+    EXPECT_FLOAT_EQ(square.vertices()[2].x, 6.0f);
+    EXPECT_FLOAT_EQ(square.vertices()[2].y, 3.0f);
+
+    //A quarter turn moves the first vertex to the bottom right corner and its edge normal to the right
+    square.set_rotation(std::numbers::pi_v<float> * 0.5f);
+    EXPECT_NEAR(square.vertices()[0].x, 6.0f, 1e-5f);
+    EXPECT_NEAR(square.vertices()[0].y, 1.0f, 1e-5f);
+    EXPECT_NEAR(square.normals()[0].x, 1.0f, 1e-5f);
+    EXPECT_NEAR(square.normals()[0].y, 0.0f, 1e-5f);
+
+    //An eighth of a turn grows the bounds to the diagonal
+    square.set_rotation(std::numbers::pi_v<float> * 0.25f);
+    EXPECT_NEAR(square.GetBoundingBox().max_bound().x, 5.0f + std::numbers::sqrt2_v<float>, 1e-5f);
+}
+
+TEST(ShapeDistance, CircleCircle)
+{
+    const math::Circle circle_a(math::Vec2f(0.0f, 0.0f), 1.0f);
+    const math::Circle circle_b(math::Vec2f(5.0f, 0.0f), 2.0f);
+    EXPECT_FLOAT_EQ(math::Distance(circle_a, circle_b), 2.0f);
+
+    const math::Circle overlapping(math::Vec2f(2.0f, 0.0f), 2.0f);
+    EXPECT_FLOAT_EQ(math::Distance(circle_a, overlapping), -1.0f);
+}
+
+TEST(ShapeDistance, AABBCircle)
+{
+    const math::AABB aabb(math::Vec2f(0.0f, 0.0f), math::Vec2f(2.0f, 2.0f));
+    const math::Circle circle(math::Vec2f(5.0f, 1.0f), 1.0f);
+    EXPECT_FLOAT_EQ(math::Distance(aabb, circle), 2.0f);
+    EXPECT_FLOAT_EQ(math::Distance(circle, aabb), 2.0f);
+}
+
+TEST(ShapeDistance, AABBAABB)
+{
+    const math::AABB aabb_a(math::Vec2f(0.0f, 0.0f), math::Vec2f(2.0f, 2.0f));
+    const math::AABB diagonal(math::Vec2f(5.0f, 6.0f), math::Vec2f(7.0f, 8.0f));
+    EXPECT_FLOAT_EQ(math::Distance(aabb_a, diagonal), 5.0f);
+
+    const math::AABB overlapping(math::Vec2f(1.5f, 1.0f), math::Vec2f(3.0f, 3.0f));
+    EXPECT_FLOAT_EQ(math::Distance(aabb_a, overlapping), -0.5f);
+}
+
+TEST(PolygonStorage, CopiesAreIndependent)
+{
+    static_assert(std::is_trivially_copyable_v<math::Polygon>);
+
+    const math::Polygon triangle({math::Vec2f(0.0f, 0.0f), math::Vec2f(3.0f, 0.0f), math::Vec2f(0.0f, 3.0f)});
+    math::Polygon copy = triangle;
+    copy.UpdatePosition(math::Vec2f(10.0f, 10.0f));
+
+    EXPECT_EQ(copy.VertexCount(), 3u);
+    EXPECT_EQ(copy.vertices().size(), 3u);
+    EXPECT_NEAR(copy.vertices()[0].x, 9.0f, 1e-5f);
+    EXPECT_NEAR(triangle.vertices()[0].x, 0.0f, 1e-5f);
+}
+
+TEST(ShapeDistance, Polygons)
+{
+    const math::Polygon square({math::Vec2f(-1.0f, -1.0f), math::Vec2f(1.0f, -1.0f), math::Vec2f(1.0f, 1.0f), math::Vec2f(-1.0f, 1.0f)});
+    const math::Polygon moved({math::Vec2f(-1.0f, -1.0f), math::Vec2f(1.0f, -1.0f), math::Vec2f(1.0f, 1.0f), math::Vec2f(-1.0f, 1.0f)},
+                              math::Vec2f(5.0f, 0.0f), 0.0f);
+
+    EXPECT_NEAR(math::Distance(square, moved), 3.0f, 1e-4f);
+    EXPECT_NEAR(math::Distance(math::Circle(math::Vec2f(0.0f, 4.0f), 1.0f), square), 2.0f, 1e-4f);
+    EXPECT_NEAR(math::Distance(square, math::AABB(math::Vec2f(-1.0f, 3.0f), math::Vec2f(1.0f, 4.0f))), 2.0f, 1e-4f);
+    EXPECT_FLOAT_EQ(math::Distance(square, square), 0.0f);
+}
+
+//Only local vertices are stored, the world ones are transformed from the current position and rotation when read
+TEST(PolygonTransform, WorldVerticesFollowTheTransform)
+{
+    math::Polygon square({math::Vec2f(-1.0f, -1.0f), math::Vec2f(1.0f, -1.0f), math::Vec2f(1.0f, 1.0f), math::Vec2f(-1.0f, 1.0f)});
+    square.set_transform(math::Vec2f(10.0f, 0.0f), std::numbers::pi_v<float> * 0.5f);
+
+    const math::Polygon& const_square = square;
+    EXPECT_NEAR(const_square.vertices()[0].x, 11.0f, 1e-5f);
+    EXPECT_NEAR(const_square.vertices()[0].y, -1.0f, 1e-5f);
+    EXPECT_NEAR(const_square.normals()[0].x, 1.0f, 1e-5f);
+
+    square.UpdatePosition(math::Vec2f(0.0f, 5.0f));
+    EXPECT_NEAR(const_square.vertices()[0].x, 1.0f, 1e-5f);
+    EXPECT_NEAR(const_square.vertices()[0].y, 4.0f, 1e-5f);
+    EXPECT_NEAR(square.BoundingRadius(), std::sqrt(2.0f), 1e-5f);
+
+    //Support searches in the local frame and returns the world vertex
+    square.set_rotation(std::numbers::pi_v<float> * 0.25f);
+    const math::Vec2f support = square.Support(math::Vec2f(1.0f, 0.0f));
+    EXPECT_NEAR(support.x, std::sqrt(2.0f), 1e-5f);
+    EXPECT_NEAR(support.y, 5.0f, 1e-5f);
+}
+
+//The box only stores its bounds, the centre and half size are derived and survive a move
+TEST(AABB, DerivedValues)
+{
+    static_assert(sizeof(math::AABB) == 16);
+
+    math::AABB box(math::Vec2f(2.0f, 3.0f), math::Vec2f(3.0f, 4.0f), 5.0f);
+    EXPECT_FLOAT_EQ(box.min_bound().x, -1.0f);
+    EXPECT_FLOAT_EQ(box.max_bound().y, 7.0f);
+    EXPECT_FLOAT_EQ(box.half_size_length(), 5.0f);
+
+    box.UpdatePosition(math::Vec2f(10.0f, 10.0f));
+    EXPECT_FLOAT_EQ(box.GetCentre().x, 10.0f);
+    EXPECT_FLOAT_EQ(box.half_size_vec().x, 3.0f);
+    EXPECT_FLOAT_EQ(box.half_size_vec().y, 4.0f);
+}
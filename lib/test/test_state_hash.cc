@@ -0,0 +1,30 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+
+#include "state_hash.h"
+
+TEST(StateHash, EqualStatesHashEqual)
+{
+    const physics::Body body_a(physics::BodyType::Dynamic, math::Vec2f(1.0f, 2.0f), math::Vec2f(3.0f, 4.0f), 5.0f);
+    const physics::Body body_b(physics::BodyType::Dynamic, math::Vec2f(1.0f, 2.0f), math::Vec2f(3.0f, 4.0f), 5.0f);
+
+    physics::StateHash hash_a;
+    physics::StateHash hash_b;
+    hash_a.Add(body_a);
+    hash_b.Add(body_b);
+    EXPECT_EQ(hash_a.value(), hash_b.value());
+}
+
+//A single bit of difference in the state changes the hash
+TEST(StateHash, DetectsOneUlp)
+{
+    const physics::Body body_a(physics::BodyType::Dynamic, math::Vec2f(1.0f, 2.0f), math::Vec2f::Zero(), 1.0f);
+    const physics::Body body_b(physics::BodyType::Dynamic, math::Vec2f(1.0f, std::nextafter(2.0f, 3.0f)), math::Vec2f::Zero(), 1.0f);
+
+    physics::StateHash hash_a;
+    physics::StateHash hash_b;
+    hash_a.Add(body_a);
+    hash_b.Add(body_b);
+    EXPECT_NE(hash_a.value(), hash_b.value());
+}
@@ -0,0 +1,51 @@
+#include <gtest/gtest.h>
+
+#include "stats.h"
+
+//The timer adds to the totals and to the step being run, the step only shows once it ends
+TEST(Stats, StepCounters)
+{
+    physics::Stats stats;
+    stats.BeginStep();
+    {
+        physics::ScopedPhaseTimer timer(stats, physics::Phase::kSolve);
+    }
+    stats.step.candidate_pairs = 3;
+    stats.step.solver_iterations += 8;
+
+    EXPECT_EQ(stats.last_step.candidate_pairs, 0u);
+    EXPECT_GE(stats[physics::Phase::kSolve], 0.0);
+
+    stats.EndStep();
+    EXPECT_EQ(stats.step_count, 1u);
+    EXPECT_EQ(stats.last_step.candidate_pairs, 3u);
+    EXPECT_EQ(stats.last_step.solver_iterations, 8u);
+    EXPECT_FLOAT_EQ(stats.last_step.StepMicroseconds(), stats.last_step.phase_microseconds[static_cast<std::size_t>(physics::Phase::kSolve)]);
+
+    stats.BeginStep();
+    EXPECT_EQ(stats.step.candidate_pairs, 0u);
+    EXPECT_EQ(stats.last_step.candidate_pairs, 3u);
+}
+
+//One sample per finished step, the offset wraps around the ring
+TEST(Stats, HistoryRecordsFinishedSteps)
+{
+    physics::Stats stats;
+    physics::StatsHistory history;
+
+    history.Record(stats);
+    EXPECT_EQ(history.offset(), 0u);
+
+    for (std::size_t i = 0; i < physics::kStatsHistoryLength + 2; ++i)
+    {
+        stats.BeginStep();
+        stats.step.phase_microseconds[static_cast<std::size_t>(physics::Phase::kBroadPhase)] = static_cast<float>(i);
+        stats.EndStep();
+        history.Record(stats);
+        history.Record(stats);
+    }
+
+    EXPECT_EQ(history.offset(), 2u);
+    EXPECT_FLOAT_EQ(history.step_microseconds()[1], static_cast<float>(physics::kStatsHistoryLength + 1));
+    EXPECT_FLOAT_EQ(history.phase_microseconds(physics::Phase::kBroadPhase)[2], 2.0f);
+}
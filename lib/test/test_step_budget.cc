@@ -0,0 +1,75 @@
+#include <gtest/gtest.h>
+
+#include "step_budget.h"
+
+//The velocity iterations go first, then the substeps, and nothing goes below one
+TEST(SolverSettings, LoadReduction)
+{
+    physics::SolverSettings settings{4, 3, 2};
+    EXPECT_EQ(settings.MaxLoadReduction(), 5);
+
+    settings.load_reduction = 1;
+    EXPECT_EQ(settings.VelocityIterations(), 2);
+    EXPECT_EQ(settings.SubstepCount(), 4);
+
+    settings.load_reduction = 4;
+    EXPECT_EQ(settings.VelocityIterations(), 1);
+    EXPECT_EQ(settings.SubstepCount(), 2);
+    EXPECT_EQ(settings.PositionIterations(), 2);
+
+    settings.load_reduction = 10;
+    EXPECT_EQ(settings.VelocityIterations(), 1);
+    EXPECT_EQ(settings.SubstepCount(), 1);
+}
+
+//Above the cap whole steps are dropped and counted, the remainder stays for the next frame
+TEST(StepBudget, CapsStepsPerFrame)
+{
+    physics::StepBudget budget;
+    budget.set_max_steps_per_frame(3);
+
+    float accumulator = 2.5f;
+    EXPECT_EQ(budget.TakeSteps(accumulator, 1.0f), 2);
+    EXPECT_FLOAT_EQ(accumulator, 0.5f);
+    EXPECT_EQ(budget.dropped_steps(), 0u);
+
+    accumulator = 10.25f;
+    EXPECT_EQ(budget.TakeSteps(accumulator, 1.0f), 3);
+    EXPECT_FLOAT_EQ(accumulator, 0.25f);
+    EXPECT_EQ(budget.dropped_steps(), 7u);
+    EXPECT_DOUBLE_EQ(budget.dropped_seconds(), 7.0);
+}
+
+TEST(StepBudget, AdaptsToStepTime)
+{
+    physics::StepBudget budget;
+    physics::SolverSettings settings{4, 4, 1};
+    constexpr float kFixedTimeStep = 1.0f;
+
+    //Off by default, the settings keep their full work
+    settings.load_reduction = 2;
+    budget.UpdateSolver(settings, 0.9f, kFixedTimeStep);
+    EXPECT_EQ(settings.load_reduction, 0);
+
+    budget.set_adaptive(true);
+    for (int i = 0; i < 200; ++i)
+    {
+        budget.UpdateSolver(settings, 0.9f, kFixedTimeStep);
+    }
+    EXPECT_GT(settings.load_reduction, 0);
+    EXPECT_LE(settings.load_reduction, settings.MaxLoadReduction());
+
+    for (int i = 0; i < 2000; ++i)
+    {
+        budget.UpdateSolver(settings, 0.1f, kFixedTimeStep);
+    }
+    EXPECT_EQ(settings.load_reduction, 0);
+
+    //Deterministic scenes are never reduced
+    settings.deterministic = true;
+    for (int i = 0; i < 200; ++i)
+    {
+        budget.UpdateSolver(settings, 0.9f, kFixedTimeStep);
+    }
+    EXPECT_EQ(settings.load_reduction, 0);
+}
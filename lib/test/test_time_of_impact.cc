@@ -0,0 +1,106 @@
+#include <gtest/gtest.h>
+
+#include <numbers>
+
+#include "time_of_impact.h"
+
+//A small circle crossing a thin wall in a single step is caught at the wall
+TEST(TimeOfImpact, CircleThroughThinWall)
+{
+    const physics::Collider bullet(math::Circle(math::Vec2f(20.0f, 0.5f), 0.5f), 1.0f, 0.0f, false);
+
+    const math::AABB wall(math::Vec2f(10.0f, -5.0f), math::Vec2f(10.5f, 5.0f));
+    const physics::Collider wall_collider(wall, 1.0f, 0.0f, false);
+
+    float time_of_impact = 1.0f;
+    ASSERT_TRUE(physics::TimeOfImpact(bullet, math::Vec2f(0.0f, 0.5f), math::Vec2f(20.0f, 0.5f),
+                                      wall_collider, wall.GetCentre(), wall.GetCentre(), time_of_impact));
+
+    //The circle touches the wall when its centre reaches x = 9.5, starting from x = 0
+    EXPECT_NEAR(time_of_impact, 9.5f / 20.0f, physics::kTimeOfImpactTolerance / 20.0f);
+}
+
+//Polygons move with their transform, so they can be swept as well
+TEST(TimeOfImpact, PolygonThroughThinWall)
+{
+    const math::Polygon triangle({math::Vec2f(-0.5f, -0.5f), math::Vec2f(0.5f, -0.5f), math::Vec2f(0.0f, 0.5f)});
+    const physics::Collider bullet(triangle, 1.0f, 0.0f, false);
+
+    const math::AABB wall(math::Vec2f(10.0f, -5.0f), math::Vec2f(10.5f, 5.0f));
+    const physics::Collider wall_collider(wall, 1.0f, 0.0f, false);
+
+    float time_of_impact = 1.0f;
+    ASSERT_TRUE(physics::TimeOfImpact(bullet, math::Vec2f(0.0f, 0.0f), math::Vec2f(20.0f, 0.0f),
+                                      wall_collider, wall.GetCentre(), wall.GetCentre(), time_of_impact));
+
+    //The right corner of the triangle reaches the wall when its centroid is at x = 9.5
+    EXPECT_NEAR(time_of_impact, 9.5f / 20.0f, physics::kTimeOfImpactTolerance / 20.0f);
+}
+
+//A circle sliding past another one just out of reach uses up the iterations without touching it
+TEST(TimeOfImpact, TangentialGrazeIsNoImpact)
+{
+    const math::Vec2f still_centre(0.0f, 2.1f);
+    const math::Circle moving(math::Vec2f(-10.0f, 0.0f), 1.0f);
+    const math::Circle still(still_centre, 1.0f);
+
+    float time_of_impact = -1.0f;
+    EXPECT_FALSE(physics::ConservativeAdvancement(moving, math::Vec2f(-10.0f, 0.0f), math::Vec2f(10.0f, 0.0f),
+                                                  still, still_centre, still_centre, time_of_impact));
+    EXPECT_FLOAT_EQ(time_of_impact, -1.0f);
+}
+
+TEST(TimeOfImpact, MissingBodies)
+{
+    const physics::Collider bullet(math::Circle(math::Vec2f(20.0f, 0.0f), 0.5f), 1.0f, 0.0f, false);
+
+    const math::Vec2f other_centre(10.0f, 5.0f);
+    const physics::Collider other(math::Circle(other_centre, 1.0f), 1.0f, 0.0f, false);
+
+    float time_of_impact = 1.0f;
+    EXPECT_FALSE(physics::TimeOfImpact(bullet, math::Vec2f(0.0f, 0.0f), math::Vec2f(20.0f, 0.0f),
+                                       other, other_centre, other_centre, time_of_impact));
+}
+
+TEST(TimeOfImpact, StillBodiesAreSkipped)
+{
+    const math::Vec2f centre(0.0f, 0.0f);
+    const physics::Collider circle_a(math::Circle(centre, 1.0f), 1.0f, 0.0f, false);
+    const physics::Collider circle_b(math::Circle(centre, 1.0f), 1.0f, 0.0f, false);
+
+    float time_of_impact = 1.0f;
+    EXPECT_FALSE(physics::TimeOfImpact(circle_a, centre, centre, circle_b, centre, centre, time_of_impact));
+}
+
+TEST(TimeOfImpact, SweptBoundingBox)
+{
+    physics::Collider collider(math::Circle(math::Vec2f(0.0f, 0.0f), 1.0f), 1.0f, 0.0f, false);
+    collider.set_sweep(math::Vec2f(10.0f, -4.0f));
+
+    const math::Bounds2f box = collider.GetSweptBoundingBox();
+    EXPECT_FLOAT_EQ(box.min_bound().x, -1.0f);
+    EXPECT_FLOAT_EQ(box.min_bound().y, -5.0f);
+    EXPECT_FLOAT_EQ(box.max_bound().x, 11.0f);
+    EXPECT_FLOAT_EQ(box.max_bound().y, 1.0f);
+}
+
+//A long bar spinning in place sweeps its tip into a post that its centre never moves towards
+TEST(TimeOfImpact, SpinningBarHitsPost)
+{
+    //Bar of half length 5, horizontal at the start and turned a quarter turn to upright at the end
+    constexpr float kQuarterTurn = std::numbers::pi_v<float> * 0.5f;
+    const math::Polygon bar({math::Vec2f(-5.0f, -0.1f), math::Vec2f(5.0f, -0.1f), math::Vec2f(5.0f, 0.1f), math::Vec2f(-5.0f, 0.1f)},
+                            math::Vec2f::Zero(), kQuarterTurn);
+    const math::Vec2f post_centre(0.0f, 4.0f);
+    const math::Circle post(post_centre, 0.5f);
+
+    float time_of_impact = -1.0f;
+    ASSERT_TRUE(physics::ConservativeAdvancement(bar, math::Vec2f::Zero(), math::Vec2f::Zero(),
+                                                 post, post_centre, post_centre, time_of_impact, kQuarterTurn));
+    //The bar comes within the radius of the post about 81 degrees into its turn
+    EXPECT_NEAR(time_of_impact, 81.0f / 90.0f, 0.05f);
+
+    //Without the turn the bar and the post are still, there is nothing to advance
+    EXPECT_FALSE(physics::ConservativeAdvancement(bar, math::Vec2f::Zero(), math::Vec2f::Zero(),
+                                                  post, post_centre, post_centre, time_of_impact));
+}
@@ -0,0 +1,69 @@
+#include <gtest/gtest.h>
+
+#include <thread>
+
+#include "triple_buffer.h"
+
+TEST(TripleBuffer, ReadsLatestPublish)
+{
+    common::TripleBuffer<int> buffer;
+    EXPECT_FALSE(buffer.Acquire());
+
+    buffer.write_buffer() = 1;
+    buffer.Publish();
+    buffer.write_buffer() = 2;
+    buffer.Publish();
+
+    //Only the latest publish is seen, and only once
+    EXPECT_TRUE(buffer.Acquire());
+    EXPECT_EQ(buffer.read_buffer(), 2);
+    EXPECT_FALSE(buffer.Acquire());
+    EXPECT_EQ(buffer.read_buffer(), 2);
+
+    //The writer never gets the buffer held by the reader
+    buffer.write_buffer() = 3;
+    EXPECT_EQ(buffer.read_buffer(), 2);
+    buffer.Publish();
+    EXPECT_TRUE(buffer.Acquire());
+    EXPECT_EQ(buffer.read_buffer(), 3);
+}
+
+//Every buffer the reader gets is a whole publish, and the values only go forward
+TEST(TripleBuffer, ConcurrentWriterAndReader)
+{
+    struct Value
+    {
+        int first = 0;
+        int second = 0;
+    };
+    constexpr int kPublishCount = 100000;
+    common::TripleBuffer<Value> buffer;
+
+    //A jthread joins on every way out of the test, and the checks only run once the writer is done
+    std::jthread writer([&buffer]
+    {
+        for (int i = 1; i <= kPublishCount; ++i)
+        {
+            buffer.write_buffer() = {i, -i};
+            buffer.Publish();
+        }
+    });
+
+    int last = 0;
+    bool torn = false;
+    bool backwards = false;
+    while (last < kPublishCount && !torn && !backwards)
+    {
+        if (buffer.Acquire())
+        {
+            const Value& value = buffer.read_buffer();
+            torn = value.first != -value.second;
+            backwards = value.first <= last;
+            last = value.first;
+        }
+    }
+    writer.join();
+
+    EXPECT_FALSE(torn);
+    EXPECT_FALSE(backwards);
+}
@@ -167,6 +167,19 @@ TEST_P(Vec2fOperatorFixture, Perpendicular)
     EXPECT_FLOAT_EQ(math::Vec2<float>::Dot(v2, r2), 0);
 }
 
+TEST_P(Vec2fOperatorFixture, Cross)
+{
+    auto [v1, v2] = GetParam();
+    const auto result = math::Vec2<float>::Cross(v1, v2);
+    EXPECT_FLOAT_EQ(result, v1.x * v2.y - v1.y * v2.x);
+    EXPECT_FLOAT_EQ(math::Vec2<float>::Cross(v1, v1), 0);
+
+    //Crossing a scalar with a vector rotates it by 90 degrees and scales it
+    const auto scaled = math::Vec2<float>::Cross(2.0f, v1);
+    EXPECT_FLOAT_EQ(math::Vec2<float>::Dot(scaled, v1), 0);
+    EXPECT_FLOAT_EQ(scaled.SquareMagnitude(), 4.0f * v1.SquareMagnitude());
+}
+
 TEST_P(Vec2fOperatorFixture, MultiplyByScalar)
 {
     auto [v1, v2] = GetParam();
@@ -1,7 +1,23 @@
+#include <charconv>
+#include <cstdint>
+#include <iostream>
+#include <string_view>
+
 #include "game_engine.h"
 
+//Usage: main [--seed seed], the seed of the deterministic scenes
 int main(int argc, char* argv[]) {
     GameEngine engine;
+    if (argc == 3 && std::string_view(argv[1]) == "--seed") {
+        const std::string_view text = argv[2];
+        std::uint64_t seed = 0;
+        const auto [end, error] = std::from_chars(text.data(), text.data() + text.size(), seed);
+        if (error != std::errc() || end != text.data() + text.size()) {
+            std::cerr << "Usage: main [--seed seed]\n";
+            return 1;
+        }
+        engine.set_scene_seed(seed);
+    }
     engine.Run();
     return 0;
-}
\ No newline at end of file
+}